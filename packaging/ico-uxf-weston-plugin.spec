@@ -55,6 +55,7 @@ install -m 0644 weston_ivi_plugin.ini %{buildroot}%{weston_conf}
 %dir %{_libdir}/weston/
 %{_libdir}/weston/*.so
 %{_libdir}/libico-uxf-weston-plugin.so.*
+%{_bindir}/ico_trace_decode
 %config(noreplace) %{weston_conf}/weston.ini
 %config(noreplace) %{weston_conf}/weston_ivi_plugin.ini
 
@@ -62,5 +63,6 @@ install -m 0644 weston_ivi_plugin.ini %{buildroot}%{weston_conf}
 %defattr(-,root,root,-)
 %{_includedir}/%{name}/ico_input_mgr-client-protocol.h
 %{_includedir}/%{name}/ico_ivi_shell-client-protocol.h
+%{_includedir}/%{name}/ico_ivi_metrics-client-protocol.h
 %{_includedir}/%{name}/ico_window_mgr-client-protocol.h
 %{_libdir}/libico-uxf-weston-plugin.so
@@ -38,6 +38,10 @@
 #include <math.h>
 #include <time.h>
 #include <sys/types.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
 
 #include <wayland-server.h>
 #include <weston/compositor.h>
@@ -46,10 +50,44 @@
 #include "ico_window_mgr.h"
 #include "ico_input_mgr-server-protocol.h"
 
+/* Plugins that must be loaded before this plugin    */
+ICO_PLUGIN_DEPENDS("ico_ivi_common.so,ico_window_mgr.so");
+
 /* degine maximum length                */
 #define ICO_MINPUT_DEVICE_LEN           32
 #define ICO_MINPUT_SW_LEN               20
 #define ICO_MINPUT_MAX_CODES            20
+#define ICO_MINPUT_DEVICE_HASH          32  /* device name hash (2's compliment)    */
+#define ICO_MINPUT_MAX_SWINDEX          256 /* maximum direct indexed input Id      */
+#define ICO_MINPUT_SWINDEX_STEP         16  /* extend step of input switch index    */
+#define ICO_MINPUT_EXINPUT_BATCH        2   /* exinput version of batched inputs    */
+#define ICO_MINPUT_EXINPUT_CAPTABLE     3   /* exinput version of capability table  */
+#define ICO_MINPUT_HIST_BUCKETS         24  /* latency histogram buckets(log2 usec) */
+#define ICO_MINPUT_DELAY_MAX            60000   /* maximum valid input delay(ms),   */
+                                                /* over is not synchronized clock   */
+#define ICO_MINPUT_COALESCE_RATE        0   /* coalesced event flush rate(/sec),    */
+                                            /* 0 is every output frame              */
+#define ICO_MINPUT_COALESCE_FALLBACK    16  /* flush interval(ms) if no frame       */
+#define ICO_MINPUT_EVDEV_PATH_LEN       64  /* evdev device path length             */
+#define ICO_MINPUT_EVDEV_MAXMAP         64  /* maximum switch map of evdev device   */
+#define ICO_MINPUT_EVDEV_READ           32  /* number of evdev events at one read   */
+#define ICO_MINPUT_EVDEV_REOPEN         1000/* retry interval of evdev re-open(ms)  */
+#define ICO_MINPUT_CHORD_TIME           100 /* default chord detect time(ms)        */
+#define ICO_MINPUT_STORE_VERSION        1   /* version of assignment store file     */
+#define ICO_MINPUT_STORE_DELAY          200 /* delay of store file write(ms)        */
+#define ICO_MINPUT_STORE_LINE           256 /* maximum line length of store file    */
+#define ICO_MINPUT_STORE_FIELDS         6   /* maximum fields of store file record  */
+
+/* gesture phase                        */
+#define ICO_MINPUT_GESTURE_IDLE         0   /* switch released                      */
+#define ICO_MINPUT_GESTURE_PRESS        1   /* pressed, wait long-press             */
+#define ICO_MINPUT_GESTURE_REPEAT       2   /* long-pressed or auto-repeating       */
+#define ICO_MINPUT_GESTURE_CHORD        3   /* pressed as chord                     */
+
+/* macro                                */
+#define MAKE_DEVICEHASH(v)  (((uint32_t)v) & (ICO_MINPUT_DEVICE_HASH-1))
+                                            /* Input Controller initialized         */
+#define ICTL_INITIALIZED(mgr)   (((mgr)->client != NULL) || ((mgr)->evdev != NULL))
 
 /* structure definition */
 /* working table of Multi Input Manager */
@@ -58,6 +96,108 @@ struct ico_input_mgr {
     struct wl_list  ictl_list;              /* Input Controller List                */
     struct wl_list  app_list;               /* application List                     */
     struct wl_resource *inputmgr;
+                                            /* Input Controller device name hash    */
+    struct ico_ictl_mgr *ictl_hash[ICO_MINPUT_DEVICE_HASH];
+    struct wl_list  batch_list;             /* application list of batched events   */
+    const char  *batch_device;              /* device of batched events(NULL=empty) */
+    uint64_t    batch_recv;                 /* receive time of oldest batched event */
+    uint32_t    cap_version;                /* version of capability table          */
+    uint32_t    cap_whole;                  /* version that needs whole table       */
+    int         cap_dirty;                  /* capability table need rebuild        */
+    struct wl_array cap_table;              /* serialized capability table          */
+    struct wl_array cap_work;               /* work for application filtered table  */
+    int         coalesce;                   /* coalesce axis input events(1=yes)    */
+    int         coalesce_rate;              /* flush rate(/sec, 0=every frame)      */
+    int         coalesce_armed;             /* flush timer or frame waiting         */
+    struct wl_list  coalesce_list;          /* input switch list of coalesced event */
+    struct ico_ivi_timer coalesce_timer;    /* flush timer                          */
+    struct weston_output *coalesce_output;  /* output of flush every frame          */
+    struct wl_listener coalesce_frame;      /* frame listener of output             */
+    struct wl_listener coalesce_destroy;    /* destroy listener of output           */
+    struct wl_list  evdev_list;             /* evdev device list                    */
+    char        *store;                     /* assignment store file(NULL=not store)*/
+    struct ico_ivi_timer store_timer;       /* delayed write timer of store file    */
+    struct ico_ivi_metric *m_routed;        /* metric: events routed to applications*/
+};
+
+/* evdev Switch Map                     */
+struct ico_evdev_map {
+    uint16_t    evtype;                     /* evdev event type(EV_KEY/EV_ABS/...)  */
+    uint16_t    evcode;                     /* evdev event code                     */
+    int32_t     input;                      /* input switch number                  */
+    int32_t     code;                       /* input code number                    */
+};
+
+/* evdev Device Table(input device read by this manager)    */
+struct ico_evdev {
+    struct wl_list link;                    /* link                                 */
+    struct ico_ictl_mgr *ictlmgr;           /* Input Controller of this device      */
+    char        path[ICO_MINPUT_EVDEV_PATH_LEN];    /* device path(or fd:N)         */
+    int         fd;                         /* file descriptor                      */
+    struct wl_event_source *source;         /* event source of fd                   */
+    struct ico_ivi_timer reopen;            /* re-open retry timer                  */
+    int         nmap;                       /* number of switch map                 */
+    struct ico_evdev_map map[ICO_MINPUT_EVDEV_MAXMAP];  /* switch map               */
+    int         len;                        /* length of read buffer                */
+    char        buf[sizeof(struct input_event) * ICO_MINPUT_EVDEV_READ];
+};
+
+/* Gesture recognition of Input Switch */
+struct ico_ictl_gesture {
+    struct ico_ictl_input *input;           /* Input Switch                         */
+    int         longpress;                  /* long-press threshold(ms, 0=none)     */
+    int         repeat_delay;               /* auto-repeat start delay(ms, 0=none)  */
+    int         repeat_rate;                /* auto-repeat rate(/sec)               */
+    int         chord;                      /* chord partner input(-1=none)         */
+    int         chord_time;                 /* chord detect time(ms)                */
+    int         raw;                        /* send raw switch event(1=send)        */
+    int         phase;                      /* gesture phase                        */
+    int         longsent;                   /* long-press event sent                */
+    uint32_t    presstime;                  /* pressed time(ms)                     */
+    uint32_t    timertime;                  /* device time(ms) of timer expiration  */
+    int32_t     code;                       /* pressed input code                   */
+    struct ico_ivi_timer timer;             /* long-press/auto-repeat timer         */
+};
+
+/* Gesture configuration(work of config parse)              */
+struct ico_gesture_conf {
+    char        *device;                    /* device name                          */
+    int         input;                      /* input switch number                  */
+    int         longpress;                  /* long-press threshold(ms)             */
+    int         repeat_delay;               /* auto-repeat start delay(ms)          */
+    int         repeat_rate;                /* auto-repeat rate(/sec)               */
+    int         chord;                      /* chord partner input                  */
+    int         chord_time;                 /* chord detect time(ms)                */
+    int         raw;                        /* send raw switch event                */
+};
+
+/* evdev Device configuration(work of config parse)         */
+struct ico_evdev_conf {
+    char        *name;                      /* device name                          */
+    char        *path;                      /* device path(or fd:N)                 */
+    int         type;                       /* device type(as enum type)            */
+    char        *switches;                  /* switch map                           */
+};
+
+/* Configuration of Multi Input Manager(user data of config parse)  */
+struct ico_input_conf {
+    struct ico_evdev_conf   *evdev;         /* [input_device] section               */
+    struct ico_gesture_conf *gesture;       /* [input_gesture] section              */
+};
+
+/* Batched input event record (input_events request/inputs event)   */
+struct ico_input_event_rec {
+    uint32_t    time;                       /* input time(miri-sec)                 */
+    int32_t     input;                      /* input switch number                  */
+    int32_t     code;                       /* input code number                    */
+    int32_t     state;                      /* input state(1=On, 0=Off)             */
+};
+
+/* Input Latency Histogram              */
+struct ico_input_hist {
+    uint32_t    count;                      /* number of samples                    */
+    uint32_t    max;                        /* maximum latency(usec)                */
+    uint32_t    bucket[ICO_MINPUT_HIST_BUCKETS];    /* bucket n: < 2^n usec         */
 };
 
 /* Input Switch Table                   */
@@ -68,12 +208,34 @@ struct ico_ictl_code {
 
 struct ico_ictl_input {
     struct wl_list link;                    /* link                                 */
+    struct ico_ictl_mgr *ictlmgr;           /* Input Controller of this switch      */
     char        swname[ICO_MINPUT_SW_LEN];  /* input switch name                    */
     int32_t     input;                      /* input Id                             */
-    uint16_t    fix;                        /* fixed assign to application          */
     uint16_t    ncode;                      /* number of codes                      */
     struct ico_ictl_code code[ICO_MINPUT_MAX_CODES];   /* codes                     */
-    struct ico_app_mgr  *app;               /* send event tagret application        */
+    struct wl_list sub_list;                /* subscriber(application) list         */
+    int         nroute;                     /* number of send event target          */
+    int         maxroute;                   /* allocated size of route              */
+    struct ico_app_mgr  **route;            /* send event target applications       */
+    struct wl_array cap;                    /* serialized capability(size 0=update) */
+    int32_t     type;                       /* switch type(as enum type)            */
+    int32_t     pending;                    /* coalesced event pending(1=pending)   */
+    struct wl_list coalesce_link;           /* link of coalesced event list         */
+    uint32_t    pend_time;                  /* coalesced event time                 */
+    uint64_t    pend_recv;                  /* receive time of first coalesced(usec)*/
+    int         pend_delay;                 /* input delay of coalesced event(usec) */
+    int32_t     pend_code;                  /* coalesced event code                 */
+    int32_t     pend_state;                 /* coalesced event state                */
+    struct ico_ictl_gesture *gesture;       /* gesture recognition(NULL=none)       */
+};
+
+/* Input Switch Subscriber Table        */
+struct ico_ictl_sub {
+    struct wl_list input_link;              /* link of input switch subscriber list */
+    struct wl_list app_link;                /* link of application assigned list    */
+    struct ico_ictl_input *input;           /* subscribed input switch              */
+    struct ico_app_mgr  *app;               /* subscriber application               */
+    uint32_t    flags;                      /* fixed/shared flags(as enum assign)   */
 };
 
 /* Input Controller Management Table    */
@@ -83,7 +245,14 @@ struct ico_ictl_mgr {
     struct wl_resource  *resource;          /* resource                             */
     char    device[ICO_MINPUT_DEVICE_LEN];  /* device name                          */
     int     type;                           /* device type                          */
+    uint32_t    hash;                       /* hash value of device name            */
+    struct ico_ictl_mgr *next_hash;         /* next device in same hash bucket      */
     struct wl_list ico_ictl_input;          /* list of input switchs                */
+    int     nswindex;                       /* size of input switch index           */
+    struct ico_ictl_input **swindex;        /* input switch index by input Id       */
+    uint32_t    unsync;                     /* number of not synchronized time      */
+    struct ico_input_hist delay;            /* input time to receive latency        */
+    struct ico_evdev *evdev;                /* evdev device(if read by this manager)*/
 };
 
 /* Application Management Table */
@@ -92,6 +261,13 @@ struct ico_app_mgr {
     struct wl_client    *client;            /* client                               */
     struct wl_resource  *resource;          /* resource for send event              */
     struct wl_resource  *mgr_resource;      /* resource as manager(if NULL, client) */
+    uint32_t    version;                    /* bound version of ico_exinput         */
+    uint32_t    cap_version;                /* capability table version of app      */
+    struct wl_list      batch_link;         /* link of batched events list          */
+    struct wl_list      input_list;         /* assigned input switch subscriber list*/
+    struct ico_input_hist delay;            /* input time to receive latency        */
+    struct ico_input_hist dispatch;         /* receive to send event latency        */
+    struct wl_array     batch;              /* batched events to application        */
     char    appid[ICO_IVI_APPID_LENGTH];    /* application id                       */
 };
 
@@ -112,11 +288,15 @@ static void ico_exinput_bind(struct wl_client *client, void *data,
 /* unbind input manager (form application)          */
 static void ico_exinput_unbind(struct wl_resource *resource);
 
+/* make hash value of device name   */
+static uint32_t device_name_hash(const char *device);
 /* find ictl manager by device name */
 static struct ico_ictl_mgr *find_ictlmgr_by_device(const char *device);
 /* find ictl input switch by input Id */
 static struct ico_ictl_input *find_ictlinput_by_input(struct ico_ictl_mgr *pIctlMgr,
                                                       const int32_t input);
+/* regist input switch to input Id index */
+static int index_ictlinput(struct ico_ictl_mgr *pIctlMgr, struct ico_ictl_input *pInput);
 /* find app manager by application Id */
 static struct ico_app_mgr *find_app_by_appid(const char *appid);
 /* add input event to application     */
@@ -139,6 +319,100 @@ static void ico_device_configure_code(struct wl_client *client,
 static void ico_device_input_event(struct wl_client *client, struct wl_resource *resource,
                                    uint32_t time, const char *device,
                                    int32_t input, int32_t code, int32_t state);
+/* device batched input events              */
+static void ico_device_input_events(struct wl_client *client, struct wl_resource *resource,
+                                    const char *device, struct wl_array *events);
+/* create Application Management table      */
+static struct ico_app_mgr *create_app_mgr(const char *appid);
+/* subscribe input switch to application    */
+static int subscribe_input_app(struct ico_ictl_input *pInput, struct ico_app_mgr *pAppMgr,
+                               const uint32_t flags);
+/* unsubscribe input switch from application*/
+static void unsubscribe_input_app(struct ico_ictl_sub *pSub);
+/* find subscriber of input switch          */
+static struct ico_ictl_sub *find_sub_by_app(struct ico_ictl_input *pInput,
+                                            struct ico_app_mgr *pAppMgr);
+/* check fixed assign to other application  */
+static struct ico_app_mgr *input_fixed_other(struct ico_ictl_input *pInput,
+                                             struct ico_app_mgr *pAppMgr);
+/* update send event target of input switch */
+static void update_input_route(struct ico_ictl_input *pInput);
+/* coalesce axis input event               */
+static int coalesce_input_event(struct ico_ictl_input *pInput, const uint32_t time,
+                                const int32_t code, const int32_t state,
+                                const uint64_t recvtime, const int delay);
+/* schedule flush of coalesced events       */
+static void coalesce_schedule(void);
+/* flush coalesced events                   */
+static void coalesce_flush(void);
+/* flush timer of coalesced events          */
+static void coalesce_timer(void *data);
+/* output frame of flush coalesced events   */
+static void coalesce_frame(struct wl_listener *listener, void *data);
+/* output of coalesced events destroyed     */
+static void coalesce_output_destroy(struct wl_listener *listener, void *data);
+/* add event to batch of application        */
+static int batch_add(const char *device, const uint64_t recvtime,
+                     struct ico_app_mgr *pAppMgr, const struct ico_input_event_rec *rec);
+/* send batched events to applications      */
+static void batch_send(void);
+/* recognize gesture of switch event       */
+static void gesture_input_event(struct ico_ictl_input *pInput, const uint32_t time,
+                                const int32_t code, const int32_t state);
+/* timer of long-press/auto-repeat          */
+static void gesture_timer(void *data);
+/* send synthesized gesture event           */
+static void gesture_send(struct ico_ictl_input *pInput, const uint32_t time,
+                         const int32_t code, const int32_t state);
+/* create gesture from configuration        */
+static struct ico_ictl_gesture *gesture_create(const char *device, const int input);
+/* set gesture from configuration           */
+static void gesture_config(void *data);
+/* load switchs and fixed assigns          */
+static void store_load(void);
+/* schedule write of store file             */
+static void store_schedule(void);
+/* write switchs and fixed assigns          */
+static void store_write(void *data);
+/* split record of store file               */
+static int store_split(char *line, char **field);
+/* check field of store file                */
+static int store_field(const char *name);
+/* create evdev device from configuration  */
+static void evdev_config(void *data);
+/* open evdev device                        */
+static int evdev_open(struct ico_evdev *evdev);
+/* read evdev device                        */
+static int evdev_dispatch(int fd, uint32_t mask, void *data);
+/* retry re-open of evdev device            */
+static void evdev_reopen(void *data);
+/* put 32bits value to capability record    */
+static int cap_put_uint(struct wl_array *array, const uint32_t value);
+/* put string to capability record          */
+static int cap_put_string(struct wl_array *array, const char *str);
+/* serialize capability of input switch     */
+static int cap_serialize(struct ico_ictl_input *pInput);
+/* get capability table for application     */
+static struct wl_array *cap_get_table(struct ico_app_mgr *pAppMgr);
+/* capability table changed                */
+static void cap_change(const int whole);
+/* send capability change to applications   */
+static void cap_send_change(struct ico_ictl_mgr *pIctlMgr, struct ico_ictl_input *pInput);
+/* query input latency histograms           */
+static void ico_mgr_query_latency(struct wl_client *client, struct wl_resource *resource,
+                                  const char *device, const char *appid, uint32_t reset);
+/* current time(micro-sec)                  */
+static uint64_t input_now_usec(void);
+/* record input delay of device event       */
+static int input_delay(struct ico_ictl_mgr *pIctlMgr, const uint32_t time,
+                       const uint64_t recvtime);
+/* add sample to latency histogram          */
+static void hist_record(struct ico_input_hist *hist, const uint32_t usec);
+/* percentile of latency histogram          */
+static uint32_t hist_percentile(const struct ico_input_hist *hist, const int percent);
+/* send latency histogram to manager        */
+static void send_latency(struct wl_resource *resource, const char *target,
+                         const int kind, struct ico_input_hist *hist, const uint32_t reset);
 
 /* entry finction called by Weston  */
 WL_EXPORT int module_init(struct weston_compositor *ec);
@@ -148,13 +422,15 @@ WL_EXPORT int module_init(struct weston_compositor *ec);
 static const struct ico_input_mgr_control_interface ico_input_mgr_implementation = {
     ico_mgr_add_input_app,
     ico_mgr_del_input_app,
+    ico_mgr_query_latency
 };
 
 /* Input Controller interface */
 static const struct ico_input_mgr_device_interface input_mgr_ictl_implementation = {
     ico_device_configure_input,
     ico_device_configure_code,
-    ico_device_input_event
+    ico_device_input_event,
+    ico_device_input_events
 };
 
 /* definition of class variable */
@@ -170,7 +446,8 @@ struct ico_input_mgr    *pInputMgr = NULL;
  * @param[in]   appid           target application id
  * @param[in]   device          device name
  * @param[in]   input           input switch number
- * @param[in]   fix             fix to application(1=fix,0=general)
+ * @param[in]   fix             assign flags(ICO_INPUT_MGR_CONTROL_ASSIGN_FIX: fixed,
+ *                              ICO_INPUT_MGR_CONTROL_ASSIGN_SHARED: shared with others)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
@@ -178,6 +455,8 @@ static void
 ico_mgr_add_input_app(struct wl_client *client, struct wl_resource *resource,
                       const char *appid, const char *device, int32_t input, uint32_t fix)
 {
+    uifw_watch("input_mgr.add_input_app", input, fix);
+
     uifw_trace("ico_mgr_add_input_app: Enter(appid=%s,dev=%s,input=%d,fix=%d)",
                appid, device, input, fix);
 
@@ -210,18 +489,18 @@ ico_mgr_add_input_app(struct wl_client *client, struct wl_resource *resource,
     pAppMgr = find_app_by_appid(appid);
     if (! pAppMgr)  {
         /* create Application Management Table  */
-        pAppMgr = (struct ico_app_mgr *)malloc(sizeof(struct ico_app_mgr));
+        pAppMgr = create_app_mgr(appid);
         if (! pAppMgr)  {
             uifw_error("ico_mgr_add_input_app: Leave(No Memory)");
             return;
         }
-        memset(pAppMgr, 0, sizeof(struct ico_app_mgr));
-        strncpy(pAppMgr->appid, appid, sizeof(pAppMgr->appid)-1);
-        wl_list_insert(pInputMgr->app_list.prev, &pAppMgr->link);
     }
 
-    pInput->app = pAppMgr;
-    pInput->fix = fix;
+    if (subscribe_input_app(pInput, pAppMgr, fix) != ICO_IVI_EOK)  {
+        uifw_warn("ico_mgr_add_input_app: Leave(%s.%s[%d] can not assign to %s)",
+                  pIctlMgr->device, pInput->swname, input, pAppMgr->appid);
+        return;
+    }
     uifw_trace("ico_mgr_add_input_app: Leave(%s.%s[%d] assign to %s)",
                pIctlMgr->device, pInput->swname ? pInput->swname : "(NULL)", input,
                pAppMgr->appid);
@@ -246,12 +525,16 @@ static void
 ico_mgr_del_input_app(struct wl_client *client, struct wl_resource *resource,
                       const char *appid, const char *device, int32_t input)
 {
+    uifw_watch("input_mgr.del_input_app", input, 0);
+
     uifw_trace("ico_mgr_del_input_app: Enter(appid=%s,dev=%s,input=%d)",
                appid ? appid : "(NULL)", device ? device : "(NULL)", input);
 
     int     alldev = 0;
     struct ico_ictl_mgr     *pIctlMgr = NULL;
     struct ico_ictl_input   *pInput = NULL;
+    struct ico_ictl_sub     *pSub;
+    struct ico_ictl_sub     *pSubTmp;
     struct ico_app_mgr      *pAppMgr;
 
     if ((device != NULL) && (*device != 0)) {
@@ -283,71 +566,49 @@ ico_mgr_del_input_app(struct wl_client *client, struct wl_resource *resource,
             uifw_trace("ico_mgr_del_input_app: Leave(app.%s dose not exist)", appid);
             return;
         }
-        if (alldev == 0)    {
-            if (input >= 0) {
-                if (pInput->app != pAppMgr) {
-                    /* not same application, NOP        */
-                    uifw_trace("ico_mgr_del_input_app: Leave(%s.%d not app.%s, current %s)",
-                               device, input, appid,
-                               pInput->app ? pInput->app->appid : "(NULL)");
-                    return;
-                }
-                uifw_trace("ico_mgr_del_input_app: Leave(%s.%d app.%s deleted)",
+        if ((alldev == 0) && (input >= 0))  {
+            pSub = find_sub_by_app(pInput, pAppMgr);
+            if (! pSub) {
+                /* not same application, NOP        */
+                uifw_trace("ico_mgr_del_input_app: Leave(%s.%d not app.%s)",
                            device, input, appid);
-                pInput->app = NULL;
                 return;
             }
-            else    {
-                wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-                    if ((pInput->fix == 0) && (pInput->app == pAppMgr))   {
-                        uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
-                                   pIctlMgr->device, pInput->input, appid);
-                        pInput->app = NULL;
-                    }
-                }
-            }
+            uifw_trace("ico_mgr_del_input_app: Leave(%s.%d app.%s deleted)",
+                       device, input, appid);
+            unsubscribe_input_app(pSub);
+            return;
         }
-        else    {
-            /* reset all device without fixed assign    */
-            wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
-                wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-                    if ((pInput->fix == 0) && (pInput->app == pAppMgr))   {
-                        uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
-                                   pIctlMgr->device, pInput->input, pInput->app->appid);
-                        pInput->app = NULL;
-                    }
-                }
-            }
+        /* reset switchs of the application without fixed assign   */
+        wl_list_for_each_safe (pSub, pSubTmp, &pAppMgr->input_list, app_link)   {
+            if (pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX) continue;
+            if ((alldev == 0) && (pSub->input->ictlmgr != pIctlMgr))    continue;
+            uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
+                       pSub->input->ictlmgr->device, pSub->input->input, appid);
+            unsubscribe_input_app(pSub);
         }
     }
     else    {
         if (alldev == 0)    {
-            if (input >= 0) {
-                if ((pInput->fix == 0) && (pInput->app != NULL))    {
+            wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
+                if ((input >= 0) && (pInput->input != input))   continue;
+                wl_list_for_each_safe (pSub, pSubTmp, &pInput->sub_list, input_link)    {
+                    if (pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX) continue;
                     uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
-                               pIctlMgr->device, pInput->input, pInput->app->appid);
-                    pInput->app = NULL;
-                }
-            }
-            else    {
-                wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-                    if ((pInput->fix == 0) && (pInput->app != NULL))    {
-                        uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
-                               pIctlMgr->device, pInput->input, pInput->app->appid);
-                        pInput->app = NULL;
-                    }
+                               pIctlMgr->device, pInput->input, pSub->app->appid);
+                    unsubscribe_input_app(pSub);
                 }
             }
         }
         else    {
             /* reset all application without fixed assign       */
-            wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
-                wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-                    if ((pInput->fix == 0) && (pInput->app != NULL))    {
-                        uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
-                                   pIctlMgr->device, pInput->input, pInput->app->appid);
-                        pInput->app = NULL;
-                    }
+            wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
+                wl_list_for_each_safe (pSub, pSubTmp, &pAppMgr->input_list, app_link)   {
+                    if (pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX) continue;
+                    uifw_trace("ico_mgr_del_input_app: %s.%d app.%s deleted",
+                               pSub->input->ictlmgr->device, pSub->input->input,
+                               pAppMgr->appid);
+                    unsubscribe_input_app(pSub);
                 }
             }
         }
@@ -355,6 +616,83 @@ ico_mgr_del_input_app(struct wl_client *client, struct wl_resource *resource,
     uifw_trace("ico_mgr_del_input_app: Leave");
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_mgr_query_latency: query input latency histograms from HomeScreen.
+ *
+ * @param[in]   client          client(HomeScreen)
+ * @param[in]   resource        resource of request
+ * @param[in]   device          device name(if NULL or empty, all devices)
+ * @param[in]   appid           application id(if NULL or empty, all applications)
+ * @param[in]   reset           reset histograms after query(1=reset,0=not reset)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_mgr_query_latency(struct wl_client *client, struct wl_resource *resource,
+                      const char *device, const char *appid, uint32_t reset)
+{
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_app_mgr      *pAppMgr;
+    uifw_watch("input_mgr.query_latency", reset, 0);
+
+    uifw_trace("ico_mgr_query_latency: Enter(dev=%s,appid=%s,reset=%d)",
+               device ? device : "(NULL)", appid ? appid : "(NULL)", reset);
+
+    wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
+        if ((device != NULL) && (*device != 0) && (strcmp(pIctlMgr->device, device) != 0))
+            continue;
+        if (pIctlMgr->unsync > 0)   {
+            uifw_info("ico_mgr_query_latency: %s %d events not synchronized time",
+                      pIctlMgr->device, pIctlMgr->unsync);
+        }
+        send_latency(resource, pIctlMgr->device,
+                     ICO_INPUT_MGR_CONTROL_LATENCY_DEVICE_DELAY, &pIctlMgr->delay, reset);
+        if (reset)  {
+            pIctlMgr->unsync = 0;
+        }
+    }
+    wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
+        if ((appid != NULL) && (*appid != 0) && (strcmp(pAppMgr->appid, appid) != 0))
+            continue;
+        send_latency(resource, pAppMgr->appid,
+                     ICO_INPUT_MGR_CONTROL_LATENCY_APP_DELAY, &pAppMgr->delay, reset);
+        send_latency(resource, pAppMgr->appid,
+                     ICO_INPUT_MGR_CONTROL_LATENCY_APP_DISPATCH, &pAppMgr->dispatch, reset);
+    }
+    uifw_trace("ico_mgr_query_latency: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   send_latency: send latency histogram to manager(ex.HomeScreen)
+ *
+ * @param[in]   resource        resource of manager
+ * @param[in]   target          device name or application id
+ * @param[in]   kind            kind of histogram
+ * @param[in]   hist            latency histogram
+ * @param[in]   reset           reset histogram after send(1=reset,0=not reset)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+send_latency(struct wl_resource *resource, const char *target,
+             const int kind, struct ico_input_hist *hist, const uint32_t reset)
+{
+    struct wl_array buckets;
+
+    buckets.size = sizeof(hist->bucket);
+    buckets.alloc = 0;
+    buckets.data = hist->bucket;
+
+    ico_input_mgr_control_send_latency(resource, target, kind, hist->count,
+                                       hist_percentile(hist, 50),
+                                       hist_percentile(hist, 99), hist->max, &buckets);
+    if (reset)  {
+        memset(hist, 0, sizeof(struct ico_input_hist));
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_device_configure_input: configure input device and input switch
@@ -376,6 +714,8 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
                            const char *device, int32_t type, const char *swname,
                            int32_t input, const char *codename, int32_t code)
 {
+    uifw_watch("input_mgr.configure_input", input, code);
+
     uifw_trace("ico_device_configure_input: Enter(client=%08x,dev=%s,type=%d,swname=%s,"
                "input=%d,code=%d[%s])", (int)client, device, type,
                swname ? swname : "(NULL)", input, code, codename ? codename : " ");
@@ -383,6 +723,7 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
     struct ico_ictl_mgr     *pIctlMgr;
     struct ico_ictl_input   *pInput;
     struct ico_app_mgr      *pAppMgr;
+    int                     whole = 0;
 
     pIctlMgr = find_ictlmgr_by_device(device);
     if (! pIctlMgr) {
@@ -398,8 +739,19 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
         wl_list_init(&pIctlMgr->ico_ictl_input);
         strncpy(pIctlMgr->device, device, sizeof(pIctlMgr->device)-1);
 
-        /* add list */
+        /* add list and device name hash (hash value resolved only at here)  */
         wl_list_insert(pInputMgr->ictl_list.prev, &pIctlMgr->link);
+        pIctlMgr->hash = device_name_hash(pIctlMgr->device);
+        pIctlMgr->next_hash = pInputMgr->ictl_hash[MAKE_DEVICEHASH(pIctlMgr->hash)];
+        pInputMgr->ictl_hash[MAKE_DEVICEHASH(pIctlMgr->hash)] = pIctlMgr;
+    }
+    if (((! ICTL_INITIALIZED(pIctlMgr)) && (client != NULL)) ||
+        ((type) && (type != pIctlMgr->type)))    {
+        /* device appears or changes, all switchs of device are changed */
+        wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
+            pInput->cap.size = 0;
+        }
+        whole = 1;
     }
     pIctlMgr->client = client;
     pIctlMgr->resource = resource;
@@ -408,10 +760,8 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
     }
 
     /* search and add input switch  */
-    wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-        if (pInput->input == input)     break;
-    }
-    if (&pInput->link == &pIctlMgr->ico_ictl_input)    {
+    pInput = find_ictlinput_by_input(pIctlMgr, input);
+    if (! pInput)   {
         uifw_trace("ico_device_configure_input: create %s.%s(%d) switch",
                    device, swname, input);
         pInput = (struct ico_ictl_input *)malloc(sizeof(struct ico_ictl_input));
@@ -426,11 +776,23 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
         else    {
             strcpy(pInput->swname, "(Unknown)");
         }
+        pInput->input = input;
+        pInput->ictlmgr = pIctlMgr;
+        wl_list_init(&pInput->sub_list);
+        wl_list_init(&pInput->coalesce_link);
+        wl_array_init(&pInput->cap);
         wl_list_insert(pIctlMgr->ico_ictl_input.prev, &pInput->link);
+        if (index_ictlinput(pIctlMgr, pInput) != ICO_IVI_EOK)   {
+            uifw_warn("ico_device_configure_input: %s.%d not indexed(No Memory)",
+                      device, input);
+        }
     }
     if (swname) {
         strncpy(pInput->swname, swname, sizeof(pInput->swname)-1);
     }
+    if (type)   {
+        pInput->type = type;
+    }
     pInput->input = input;
     memset(pInput->code, 0, sizeof(pInput->code));
     pInput->ncode = 1;
@@ -438,6 +800,9 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
     if (codename)   {
         strncpy(pInput->code[0].name, codename, sizeof(pInput->code[0].name)-1);
     }
+    pInput->cap.size = 0;
+    cap_change(whole);
+    store_schedule();
 
     if (client == NULL) {
         /* internal call for table create   */
@@ -446,9 +811,11 @@ ico_device_configure_input(struct wl_client *client, struct wl_resource *resourc
     }
 
     /* send to application and manager(ex.HomeScreen)   */
+    cap_send_change(pIctlMgr, pInput);
     wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
         if (pAppMgr->resource == NULL)  continue;
-        if ((pInput->app != NULL) && (pInput->app != pAppMgr) && (pInput->fix)) continue;
+        if (pAppMgr->version >= ICO_MINPUT_EXINPUT_CAPTABLE)    continue;
+        if (input_fixed_other(pInput, pAppMgr)) continue;
 
         uifw_trace("ico_device_configure_input: send capabilities to app(%s) %s.%s[%d]",
                    pAppMgr->appid, device, pInput->swname, input);
@@ -477,6 +844,8 @@ ico_device_configure_code(struct wl_client *client, struct wl_resource *resource
                           const char *device, int32_t input,
                           const char *codename, int32_t code)
 {
+    uifw_watch("input_mgr.configure_code", input, code);
+
     uifw_trace("ico_device_configure_code: Enter(client=%08x,dev=%s,input=%d,code=%d[%s])",
                (int)client, device, input, code, codename ? codename : " ");
 
@@ -491,10 +860,8 @@ ico_device_configure_code(struct wl_client *client, struct wl_resource *resource
         return;
     }
     /* search input switch      */
-    wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-        if (pInput->input == input)     break;
-    }
-    if (&pInput->link == &pIctlMgr->ico_ictl_input)    {
+    pInput = find_ictlinput_by_input(pIctlMgr, input);
+    if (! pInput)   {
         uifw_warn("ico_device_configure_code: Leave(input=%s.%d dose not exist)",
                   device, input);
         return;
@@ -517,11 +884,16 @@ ico_device_configure_code(struct wl_client *client, struct wl_resource *resource
     }
     memset(pInput->code[i].name, 0, sizeof(pInput->code[i].name));
     strncpy(pInput->code[i].name, codename, sizeof(pInput->code[i].name)-1);
+    pInput->cap.size = 0;
+    cap_change(0);
+    store_schedule();
 
     /* send to application and manager(ex.HomeScreen)   */
+    cap_send_change(pIctlMgr, pInput);
     wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
         if (pAppMgr->resource == NULL)  continue;
-        if ((pInput->app != NULL) && (pInput->app != pAppMgr) && (pInput->fix)) continue;
+        if (pAppMgr->version >= ICO_MINPUT_EXINPUT_CAPTABLE)    continue;
+        if (input_fixed_other(pInput, pAppMgr)) continue;
         uifw_trace("ico_device_configure_input: send code to app(%s) %s.%s[%d]",
                    pAppMgr->appid, device, pInput->swname, input);
         ico_exinput_send_code(pAppMgr->resource, device, input,
@@ -549,11 +921,17 @@ ico_device_input_event(struct wl_client *client, struct wl_resource *resource,
                        uint32_t time, const char *device,
                        int32_t input, int32_t code, int32_t state)
 {
+    uint64_t    recvtime = input_now_usec();
+    uifw_watch("input_mgr.input_event", input, code);
+
     uifw_trace("ico_device_input_event: Enter(time=%d,dev=%s,input=%d,code=%d,state=%d)",
                time, device, input, code, state);
 
     struct ico_ictl_mgr     *pIctlMgr;
     struct ico_ictl_input   *pInput;
+    struct ico_app_mgr      *pAppMgr;
+    int                     delay;
+    int                     i;
 
     /* find input devcie by client      */
     pIctlMgr = find_ictlmgr_by_device(device);
@@ -568,20 +946,210 @@ ico_device_input_event(struct wl_client *client, struct wl_resource *resource,
                   pIctlMgr->device, input);
         return;
     }
+    delay = input_delay(pIctlMgr, time, recvtime);
+    uifw_btrace(ICO_TP_INPUT_EVENT, time, input, code, state, pInput->nroute);
+
+    if ((pInput->gesture) && (! pInput->gesture->raw))  {
+        uifw_trace("ico_device_input_event: %s.%s raw event not send",
+                   pIctlMgr->device, pInput->swname);
+    }
+    else if (pInput->nroute <= 0)   {
+        uifw_trace("ico_device_input_event: %s.%s not assign",
+                   pIctlMgr->device, pInput->swname);
+    }
+    else if (coalesce_input_event(pInput, time, code, state, recvtime, delay))  {
+        uifw_trace("ico_device_input_event: %s.%s coalesced",
+                   pIctlMgr->device, pInput->swname);
+    }
+    else    {
+        /* send event to all subscribed applications    */
+        ico_ivi_metric_add(pInputMgr->m_routed, pInput->nroute);
+        for (i = 0; i < pInput->nroute; i++)    {
+            pAppMgr = pInput->route[i];
+            uifw_trace("ico_device_input_event: send event=%s.%s[%d],%d,%d to App.%s",
+                       pIctlMgr->device, pInput->swname, input, code, state,
+                       pAppMgr->appid);
+            ico_exinput_send_input(pAppMgr->resource, time, pIctlMgr->device,
+                                   input, code, state);
+            if (delay >= 0) {
+                hist_record(&pAppMgr->delay, (uint32_t)delay);
+            }
+            hist_record(&pAppMgr->dispatch, (uint32_t)(input_now_usec() - recvtime));
+        }
+    }
+
+    if (pInput->gesture)    {
+        /* synthesized gesture events after raw event   */
+        gesture_input_event(pInput, time, code, state);
+        batch_send();
+    }
+    uifw_trace("ico_device_input_event: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_device_input_events: batched device input events from
+ *          Device Input Controller.
+ *
+ * @param[in]   client          client(Device Input Controller)
+ * @param[in]   resource        resource of request
+ * @param[in]   device          device name
+ * @param[in]   events          array of input event record(ico_input_event_rec)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+ico_device_input_events(struct wl_client *client, struct wl_resource *resource,
+                        const char *device, struct wl_array *events)
+{
+    uint64_t    recvtime = input_now_usec();
+    uifw_watch("input_mgr.input_events", events->size, 0);
+
+    uifw_trace("ico_device_input_events: Enter(dev=%s,size=%d)", device, (int)events->size);
+
+    struct ico_ictl_mgr         *pIctlMgr;
+    struct ico_ictl_input       *pInput;
+    struct ico_app_mgr          *pAppMgr;
+    struct ico_input_event_rec  *rec;
+    int                         nrec;
+    int                         i;
+    int                         j;
+    int                         delay;
 
-    if (! pInput->app)  {
-        uifw_trace("ico_device_input_event: Leave(%s.%s not assign)",
-                  pIctlMgr->device, pInput->swname);
+    /* find input devcie by device name */
+    pIctlMgr = find_ictlmgr_by_device(device);
+    if (! pIctlMgr) {
+        uifw_error("ico_device_input_events: Leave(Unknown device(%s))", device);
         return;
     }
+    nrec = events->size / sizeof(struct ico_input_event_rec);
+    rec = (struct ico_input_event_rec *)events->data;
+
+    /* route each record to target application  */
+    for (i = 0; i < nrec; i++)  {
+        pInput = find_ictlinput_by_input(pIctlMgr, rec[i].input);
+        if (! pInput)   {
+            uifw_warn("ico_device_input_events: Unknown input(%s,%d)",
+                      pIctlMgr->device, rec[i].input);
+            continue;
+        }
+        delay = input_delay(pIctlMgr, rec[i].time, recvtime);
+        uifw_btrace(ICO_TP_INPUT_EVENT, rec[i].time, rec[i].input, rec[i].code,
+                    rec[i].state, pInput->nroute);
+        if ((pInput->gesture) && (! pInput->gesture->raw))  {
+            /* raw event not send           */
+        }
+        else if (pInput->nroute <= 0)   {
+            uifw_trace("ico_device_input_events: %s.%d not assign",
+                       pIctlMgr->device, rec[i].input);
+        }
+        else if (! coalesce_input_event(pInput, rec[i].time, rec[i].code, rec[i].state,
+                                        recvtime, delay))   {
+            ico_ivi_metric_add(pInputMgr->m_routed, pInput->nroute);
+            for (j = 0; j < pInput->nroute; j++)    {
+                pAppMgr = pInput->route[j];
+                if (delay >= 0) {
+                    hist_record(&pAppMgr->delay, (uint32_t)delay);
+                }
+                if (batch_add(pIctlMgr->device, recvtime, pAppMgr, &rec[i]) != ICO_IVI_EOK) {
+                    uifw_error("ico_device_input_events: %s.%d lost(No Memory)",
+                               pIctlMgr->device, rec[i].input);
+                }
+            }
+        }
+        if (pInput->gesture)    {
+            /* synthesized gesture events after raw event in batch  */
+            gesture_input_event(pInput, rec[i].time, rec[i].code, rec[i].state);
+        }
+    }
 
-    /* send event to application        */
-    uifw_trace("ico_device_input_event: send event=%s.%s[%d],%d,%d to App.%s",
-               pIctlMgr->device, pInput->swname, input, code, state, pInput->app->appid);
-    ico_exinput_send_input(pInput->app->resource, time, pIctlMgr->device,
-                           input, code, state);
+    /* send batched events to each application  */
+    batch_send();
+    uifw_trace("ico_device_input_events: Leave");
+}
 
-    uifw_trace("ico_device_input_event: Leave");
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_add: add event to batch of application.
+ *          batch has events of one device, batch of other device is sent
+ *          before adding.
+ *
+ * @param[in]   device          device name(name in Input Controller table)
+ * @param[in]   recvtime        receive time of event(usec)
+ * @param[in]   pAppMgr         application
+ * @param[in]   rec             input event record
+ * @return      result
+ * @retval      ICO_IVI_EOK     success
+ * @retval      ICO_IVI_ENOMEM  error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+batch_add(const char *device, const uint64_t recvtime,
+          struct ico_app_mgr *pAppMgr, const struct ico_input_event_rec *rec)
+{
+    struct ico_input_event_rec  *dst;
+
+    if ((pInputMgr->batch_device) && (pInputMgr->batch_device != device))  {
+        /* batched events of other device   */
+        batch_send();
+    }
+    if (! pInputMgr->batch_device)  {
+        pInputMgr->batch_device = device;
+        pInputMgr->batch_recv = recvtime;
+    }
+    else if (recvtime < pInputMgr->batch_recv)  {
+        pInputMgr->batch_recv = recvtime;
+    }
+
+    dst = (struct ico_input_event_rec *)
+              wl_array_add(&pAppMgr->batch, sizeof(struct ico_input_event_rec));
+    if (! dst)  {
+        return ICO_IVI_ENOMEM;
+    }
+    *dst = *rec;
+    if (pAppMgr->batch.size == sizeof(struct ico_input_event_rec))  {
+        /* first event of this application  */
+        wl_list_insert(pInputMgr->batch_list.prev, &pAppMgr->batch_link);
+    }
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   batch_send: send batched events of one device to each application
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+batch_send(void)
+{
+    const char                  *device = pInputMgr->batch_device;
+    uint64_t                    recvtime = pInputMgr->batch_recv;
+    struct ico_app_mgr          *pAppMgr;
+    struct ico_app_mgr          *pAppMgrTmp;
+    struct ico_input_event_rec  *dst;
+
+    wl_list_for_each_safe (pAppMgr, pAppMgrTmp, &pInputMgr->batch_list, batch_link)  {
+        uifw_trace("batch_send: send %d events=%s to App.%s",
+                   (int)(pAppMgr->batch.size / sizeof(struct ico_input_event_rec)),
+                   device, pAppMgr->appid);
+        if (pAppMgr->version >= ICO_MINPUT_EXINPUT_BATCH)   {
+            ico_exinput_send_inputs(pAppMgr->resource, device, &pAppMgr->batch);
+        }
+        else    {
+            /* old application, send each event */
+            wl_array_for_each (dst, &pAppMgr->batch)    {
+                ico_exinput_send_input(pAppMgr->resource, dst->time, device,
+                                       dst->input, dst->code, dst->state);
+            }
+        }
+        pAppMgr->batch.size = 0;
+        wl_list_remove(&pAppMgr->batch_link);
+        hist_record(&pAppMgr->dispatch, (uint32_t)(input_now_usec() - recvtime));
+    }
+    pInputMgr->batch_device = NULL;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -600,6 +1168,7 @@ ico_control_bind(struct wl_client *client, void *data, uint32_t version, uint32_
 {
     char                    *appid;
     struct ico_app_mgr      *pAppMgr;
+    uifw_watch("input_mgr.control_bind", client, id);
 
     uifw_trace("ico_control_bind: Enter(client=%08x)", (int)client);
     appid = ico_window_mgr_appid(client);
@@ -614,14 +1183,11 @@ ico_control_bind(struct wl_client *client, void *data, uint32_t version, uint32_
     pAppMgr = find_app_by_appid(appid);
     if (! pAppMgr)  {
         /* create Application Management Table  */
-        pAppMgr = (struct ico_app_mgr *)malloc(sizeof(struct ico_app_mgr));
+        pAppMgr = create_app_mgr(appid);
         if (! pAppMgr)  {
             uifw_error("ico_control_bind: Leave(No Memory)");
             return;
         }
-        memset(pAppMgr, 0, sizeof(struct ico_app_mgr));
-        strncpy(pAppMgr->appid, appid, sizeof(pAppMgr->appid)-1);
-        wl_list_insert(pInputMgr->app_list.prev, &pAppMgr->link);
     }
     pAppMgr->client = client;
     if (! pAppMgr->mgr_resource)    {
@@ -676,6 +1242,7 @@ static void
 ico_device_bind(struct wl_client *client, void *data, uint32_t version, uint32_t id)
 {
     struct wl_resource *mgr_resource;
+    uifw_watch("input_mgr.device_bind", client, id);
 
     uifw_trace("ico_device_bind: Enter(client=%08x)", (int)client);
 
@@ -708,7 +1275,7 @@ ico_device_unbind(struct wl_resource *resource)
  *
  * @param[in]   client          client(Application)
  * @param[in]   data            data(unused)
- * @param[in]   version         protocol version(unused)
+ * @param[in]   version         protocol version
  * @param[in]   id              client object id
  * @return      none
  */
@@ -719,8 +1286,12 @@ ico_exinput_bind(struct wl_client *client, void *data, uint32_t version, uint32_
     int                     i;
     char                    *appid;
     struct ico_app_mgr      *pAppMgr;
+    struct ico_app_mgr      *pFixApp;
     struct ico_ictl_mgr     *pIctlMgr;
     struct ico_ictl_input   *pInput;
+    struct ico_ictl_sub     *pSub;
+    struct wl_array         *table;
+    uifw_watch("input_mgr.exinput_bind", client, id);
 
     appid = ico_window_mgr_appid(client);
     uifw_trace("ico_exinput_bind: Enter(client=%08x,%s)", (int)client,
@@ -736,26 +1307,43 @@ ico_exinput_bind(struct wl_client *client, void *data, uint32_t version, uint32_
     pAppMgr = find_app_by_appid(appid);
     if (! pAppMgr)  {
         /* create Application Management Table  */
-        pAppMgr = (struct ico_app_mgr *)malloc(sizeof(struct ico_app_mgr));
+        pAppMgr = create_app_mgr(appid);
         if (! pAppMgr)  {
             uifw_error("ico_exinput_bind: Leave(No Memory)");
             return;
         }
-        memset(pAppMgr, 0, sizeof(struct ico_app_mgr));
-        strncpy(pAppMgr->appid, appid, sizeof(pAppMgr->appid)-1);
-        wl_list_insert(pInputMgr->app_list.prev, &pAppMgr->link);
         uifw_trace("ico_exinput_bind: Create App.%s table", appid);
     }
     pAppMgr->client = client;
     if (! pAppMgr->resource)    {
         pAppMgr->resource = wl_client_add_object(client, &ico_exinput_interface,
-                                                 NULL, id, pInputMgr);
+                                                 NULL, id, pAppMgr);
         pAppMgr->resource->destroy = ico_exinput_unbind;
+        pAppMgr->version = version;
+
+        /* fixed assigned switchs send event to new resource    */
+        wl_list_for_each (pSub, &pAppMgr->input_list, app_link) {
+            update_input_route(pSub->input);
+        }
+    }
+
+    if (pAppMgr->version >= ICO_MINPUT_EXINPUT_CAPTABLE)    {
+        /* send capability table at once    */
+        table = cap_get_table(pAppMgr);
+        if (table)  {
+            uifw_trace("ico_exinput_bind: Leave(send capability table ver=%d size=%d)",
+                       pInputMgr->cap_version, (int)table->size);
+            ico_exinput_send_capability_table(pAppMgr->resource, pInputMgr->cap_version,
+                                              0, table);
+            pAppMgr->cap_version = pInputMgr->cap_version;
+            return;
+        }
+        uifw_warn("ico_exinput_bind: capability table not created(No Memory)");
     }
 
     /* send all capabilities    */
     wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
-        if (pIctlMgr->client == NULL)   {
+        if (! ICTL_INITIALIZED(pIctlMgr))   {
             uifw_trace("ico_exinput_bind: Input controller.%s not initialized",
                        pIctlMgr->device);
             continue;
@@ -766,9 +1354,10 @@ ico_exinput_bind(struct wl_client *client, void *data, uint32_t version, uint32_
                 uifw_trace("ico_exinput_bind: Input %s not initialized", pIctlMgr->device);
                 continue;
             }
-            if ((pInput->app != NULL) && (pInput->app != pAppMgr) && (pInput->fix)) {   
+            pFixApp = input_fixed_other(pInput, pAppMgr);
+            if (pFixApp)    {
                 uifw_trace("ico_exinput_bind: Input %s.%s fixed assign to App.%s",
-                           pIctlMgr->device, pInput->swname, pInput->app->appid);
+                           pIctlMgr->device, pInput->swname, pFixApp->appid);
                 continue;
             }
             uifw_trace("ico_exinput_bind: send capabilities to app(%s) %s.%s[%d]",
@@ -797,49 +1386,65 @@ static void
 ico_exinput_unbind(struct wl_resource *resource)
 {
     struct ico_app_mgr      *pAppMgr;
-    struct ico_app_mgr      *pAppMgrTmp;
-    struct ico_ictl_mgr     *pIctlMgr;
-    struct ico_ictl_input   *pInput;
+    struct ico_ictl_sub     *pSub;
+    struct ico_ictl_sub     *pSubTmp;
     int                     fix = 0;
 
     uifw_trace("ico_exinput_unbind: Enter(resource=%08x)", (int)resource);
 
-    wl_list_for_each_safe (pAppMgr, pAppMgrTmp, &pInputMgr->app_list, link) {
-        if (pAppMgr->resource == resource)  {
-            uifw_trace("ico_exinput_unbind: find app.%s", pAppMgr->appid);
-
-            /* release application from input switch    */
-            wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
-                wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
-                    if (pInput->app == pAppMgr) {
-                        if (pInput->fix == 0)   {
-                            uifw_trace("ico_exinput_unbind: app.%s remove %s.%s",
-                                       pAppMgr->appid, pIctlMgr->device, pInput->swname);
-                            pInput->app = NULL;
-                        }
-                        else    {
-                            uifw_trace("ico_exinput_unbind: app.%s fix assign %s.%s",
-                                       pAppMgr->appid, pIctlMgr->device, pInput->swname);
-                            fix ++;
-                        }
-                    }
-                }
-            }
-            if (fix == 0)   {
-                wl_list_remove(&pAppMgr->link);
-                free(pAppMgr);
+    pAppMgr = (struct ico_app_mgr *)resource->data;
+    if ((pAppMgr != NULL) && (pAppMgr->resource == resource))   {
+        uifw_trace("ico_exinput_unbind: find app.%s", pAppMgr->appid);
+        pAppMgr->client = NULL;
+        pAppMgr->resource = NULL;
+
+        /* release application from assigned input switch   */
+        wl_list_for_each_safe (pSub, pSubTmp, &pAppMgr->input_list, app_link)   {
+            if ((pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX) == 0)  {
+                uifw_trace("ico_exinput_unbind: app.%s remove %s.%s",
+                           pAppMgr->appid, pSub->input->ictlmgr->device,
+                           pSub->input->swname);
+                unsubscribe_input_app(pSub);
             }
             else    {
-                pAppMgr->client = NULL;
-                pAppMgr->resource = NULL;
+                uifw_trace("ico_exinput_unbind: app.%s fix assign %s.%s",
+                           pAppMgr->appid, pSub->input->ictlmgr->device,
+                           pSub->input->swname);
+                update_input_route(pSub->input);
+                fix ++;
             }
         }
+        if (fix == 0)   {
+            wl_list_remove(&pAppMgr->link);
+            wl_array_release(&pAppMgr->batch);
+            free(pAppMgr);
+        }
     }
 
     free(resource);
     uifw_trace("ico_exinput_unbind: Leave");
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   device_name_hash: make hash value of device name
+ *
+ * @param[in]   device          device name
+ * @return      hash value
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+device_name_hash(const char *device)
+{
+    uint32_t    hash = 2166136261U;         /* FNV-1a                               */
+
+    for (; *device; device++)   {
+        hash ^= (uint32_t)(unsigned char)*device;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   find_ictlmgr_by_device: find Input Controller by device name
@@ -854,11 +1459,16 @@ static struct ico_ictl_mgr *
 find_ictlmgr_by_device(const char *device)
 {
     struct ico_ictl_mgr     *pIctlMgr;
+    uint32_t                hash;
 
-    wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
-        if (strcmp(pIctlMgr->device, device) == 0)  {
+    hash = device_name_hash(device);
+    pIctlMgr = pInputMgr->ictl_hash[MAKE_DEVICEHASH(hash)];
+
+    while (pIctlMgr)    {
+        if ((pIctlMgr->hash == hash) && (strcmp(pIctlMgr->device, device) == 0))  {
             return pIctlMgr;
         }
+        pIctlMgr = pIctlMgr->next_hash;
     }
     return NULL;
 }
@@ -879,6 +1489,12 @@ find_ictlinput_by_input(struct ico_ictl_mgr *pIctlMgr, const int32_t input)
 {
     struct ico_ictl_input   *pInput;
 
+    if ((input >= 0) && (input < pIctlMgr->nswindex) &&
+        (pIctlMgr->swindex[input] != NULL)) {
+        /* direct indexed input Id      */
+        return pIctlMgr->swindex[input];
+    }
+    /* out of index range(or index not registered), search list */
     wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
         if (pInput->input == input) {
             return pInput;
@@ -887,6 +1503,46 @@ find_ictlinput_by_input(struct ico_ictl_mgr *pIctlMgr, const int32_t input)
     return NULL;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   index_ictlinput: regist Input Switch to input Id index of device
+ *
+ * @param[in]   pIctlMgr        Input Controller device
+ * @param[in]   pInput          Input Switch(input Id already set)
+ * @return      result
+ * @retval      ICO_IVI_EOK     success(or input Id out of index range)
+ * @retval      ICO_IVI_ENOMEM  error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+index_ictlinput(struct ico_ictl_mgr *pIctlMgr, struct ico_ictl_input *pInput)
+{
+    int     nsize;
+    struct ico_ictl_input   **swindex;
+
+    if ((pInput->input < 0) || (pInput->input >= ICO_MINPUT_MAX_SWINDEX))  {
+        /* out of index range, found by list search */
+        return ICO_IVI_EOK;
+    }
+    if (pInput->input >= pIctlMgr->nswindex)    {
+        nsize = (pInput->input + ICO_MINPUT_SWINDEX_STEP) & (~(ICO_MINPUT_SWINDEX_STEP-1));
+        if (nsize > ICO_MINPUT_MAX_SWINDEX) {
+            nsize = ICO_MINPUT_MAX_SWINDEX;
+        }
+        swindex = (struct ico_ictl_input **)
+                      realloc(pIctlMgr->swindex, sizeof(struct ico_ictl_input *) * nsize);
+        if (! swindex)  {
+            return ICO_IVI_ENOMEM;
+        }
+        memset(&swindex[pIctlMgr->nswindex], 0,
+               sizeof(struct ico_ictl_input *) * (nsize - pIctlMgr->nswindex));
+        pIctlMgr->swindex = swindex;
+        pIctlMgr->nswindex = nsize;
+    }
+    pIctlMgr->swindex[pInput->input] = pInput;
+    return ICO_IVI_EOK;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   find_app_by_appid: find Application by application Id
@@ -912,44 +1568,1642 @@ find_app_by_appid(const char *appid)
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   module_init: initialization of this plugin
+ * @brief   create_app_mgr: create Application Management table
  *
- * @param[in]   ec          weston compositor
- * @return      result
- * @retval      0           OK
- * @retval      -1          error
+ * @param[in]   appid           application Id
+ * @return      Application Management table address
+ * @retval      !=NULL          address
+ * @retval      ==NULL          error(no memory)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT int
-module_init(struct weston_compositor *ec)
+static struct ico_app_mgr *
+create_app_mgr(const char *appid)
 {
-    uifw_trace("ico_input_mgr: Enter(module_init)");
+    struct ico_app_mgr      *pAppMgr;
 
-    /* initialize management table */
-    pInputMgr = (struct ico_input_mgr *)malloc(sizeof(struct ico_input_mgr));
-    if (pInputMgr == NULL) {
-        uifw_trace("ico_input_mgr: malloc failed");
-        return -1;
+    pAppMgr = (struct ico_app_mgr *)malloc(sizeof(struct ico_app_mgr));
+    if (! pAppMgr)  {
+        return NULL;
     }
-    memset(pInputMgr, 0, sizeof(struct ico_input_mgr));
-    pInputMgr->compositor = ec;
+    memset(pAppMgr, 0, sizeof(struct ico_app_mgr));
+    strncpy(pAppMgr->appid, appid, sizeof(pAppMgr->appid)-1);
+    wl_list_init(&pAppMgr->batch_link);
+    wl_list_init(&pAppMgr->input_list);
+    wl_array_init(&pAppMgr->batch);
+    wl_list_insert(pInputMgr->app_list.prev, &pAppMgr->link);
+
+    return pAppMgr;
+}
 
-    /* interface to desktop manager(ex.HomeScreen)  */
-    if (wl_display_add_global(ec->wl_display,
-                              &ico_input_mgr_control_interface,
-                              pInputMgr,
-                              ico_control_bind) == NULL) {
-        uifw_trace("ico_input_mgr: wl_display_add_global mgr failed");
-        return -1;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   subscribe_input_app: subscribe input switch to application.
+ *          Exclusive subscribe removes all other subscribers, shared subscribe
+ *          removes other exclusive subscribers, but not fixed exclusive one.
+ *
+ * @param[in]   pInput          Input Switch
+ * @param[in]   pAppMgr         target application
+ * @param[in]   flags           assign flags(as enum assign)
+ * @return      result
+ * @retval      ICO_IVI_EOK     success
+ * @retval      ICO_IVI_EBUSY   error(fixed exclusive assign to other application)
+ * @retval      ICO_IVI_ENOMEM  error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+subscribe_input_app(struct ico_ictl_input *pInput, struct ico_app_mgr *pAppMgr,
+                    const uint32_t flags)
+{
+    struct ico_ictl_sub     *pSub;
+    struct ico_ictl_sub     *pSubTmp;
+    int                     fixed;
+
+    if (flags & ICO_INPUT_MGR_CONTROL_ASSIGN_SHARED)    {
+        if (input_fixed_other(pInput, pAppMgr)) {
+            return ICO_IVI_EBUSY;
+        }
+    }
+    wl_list_for_each_safe (pSub, pSubTmp, &pInput->sub_list, input_link)    {
+        if (pSub->app == pAppMgr)   continue;
+        if ((flags & ICO_INPUT_MGR_CONTROL_ASSIGN_SHARED) &&
+            (pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_SHARED))    continue;
+        unsubscribe_input_app(pSub);
     }
 
-    /* interface to Input Controller(ictl) */
-    if (wl_display_add_global(ec->wl_display,
-                              &ico_input_mgr_device_interface,
-                              pInputMgr,
-                              ico_device_bind) == NULL) {
-        uifw_trace("ico_input_mgr: wl_display_add_global ictl failed");
-        return -1;
+    pSub = find_sub_by_app(pInput, pAppMgr);
+    if (! pSub) {
+        pSub = (struct ico_ictl_sub *)malloc(sizeof(struct ico_ictl_sub));
+        if (! pSub) {
+            return ICO_IVI_ENOMEM;
+        }
+        memset(pSub, 0, sizeof(struct ico_ictl_sub));
+        pSub->input = pInput;
+        pSub->app = pAppMgr;
+        wl_list_insert(pInput->sub_list.prev, &pSub->input_link);
+        wl_list_insert(pAppMgr->input_list.prev, &pSub->app_link);
+    }
+    if ((pSub->flags | flags) & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX)   {
+        /* fixed assign changed, save   */
+        store_schedule();
+    }
+    fixed = (pSub->flags ^ flags) & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX;
+    pSub->flags = flags;
+    if (fixed)  {
+        /* filtered capability tables of other applications changed */
+        cap_change(1);
+        cap_send_change(pInput->ictlmgr, pInput);
+    }
+    update_input_route(pInput);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   unsubscribe_input_app: unsubscribe input switch from application
+ *
+ * @param[in]   pSub            subscriber of input switch
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+unsubscribe_input_app(struct ico_ictl_sub *pSub)
+{
+    struct ico_ictl_input   *pInput = pSub->input;
+    int                     fixed;
+
+    fixed = pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX;
+    if (fixed)  {
+        /* fixed assign removed, save   */
+        store_schedule();
+    }
+    wl_list_remove(&pSub->input_link);
+    wl_list_remove(&pSub->app_link);
+    free(pSub);
+    if (fixed)  {
+        /* filtered capability tables of other applications changed */
+        cap_change(1);
+        cap_send_change(pInput->ictlmgr, pInput);
+    }
+    update_input_route(pInput);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   find_sub_by_app: find subscriber of input switch by application
+ *
+ * @param[in]   pInput          Input Switch
+ * @param[in]   pAppMgr         application
+ * @return      subscriber table address
+ * @retval      !=NULL          address
+ * @retval      ==NULL          not subscribed
+ */
+/*--------------------------------------------------------------------------*/
+static struct ico_ictl_sub *
+find_sub_by_app(struct ico_ictl_input *pInput, struct ico_app_mgr *pAppMgr)
+{
+    struct ico_ictl_sub     *pSub;
+
+    wl_list_for_each (pSub, &pInput->sub_list, input_link)  {
+        if (pSub->app == pAppMgr)   {
+            return pSub;
+        }
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   input_fixed_other: check input switch fixed exclusive assign
+ *          to other application
+ *
+ * @param[in]   pInput          Input Switch
+ * @param[in]   pAppMgr         application
+ * @return      fixed assigned application
+ * @retval      !=NULL          fixed exclusive assigned other application
+ * @retval      ==NULL          not fixed assign to other application
+ */
+/*--------------------------------------------------------------------------*/
+static struct ico_app_mgr *
+input_fixed_other(struct ico_ictl_input *pInput, struct ico_app_mgr *pAppMgr)
+{
+    struct ico_ictl_sub     *pSub;
+
+    wl_list_for_each (pSub, &pInput->sub_list, input_link)  {
+        if ((pSub->app != pAppMgr) &&
+            ((pSub->flags & (ICO_INPUT_MGR_CONTROL_ASSIGN_FIX |
+                             ICO_INPUT_MGR_CONTROL_ASSIGN_SHARED))
+                == ICO_INPUT_MGR_CONTROL_ASSIGN_FIX))   {
+            return pSub->app;
+        }
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   update_input_route: update send event target applications of
+ *          input switch(subscribers which bound ico_exinput)
+ *
+ * @param[in]   pInput          Input Switch
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+update_input_route(struct ico_ictl_input *pInput)
+{
+    struct ico_ictl_sub     *pSub;
+    struct ico_app_mgr      **route;
+    int                     num = 0;
+
+    wl_list_for_each (pSub, &pInput->sub_list, input_link)  {
+        num ++;
+    }
+    if (num > pInput->maxroute) {
+        route = (struct ico_app_mgr **)realloc(pInput->route,
+                                               sizeof(struct ico_app_mgr *) * num);
+        if (! route)    {
+            uifw_error("update_input_route: %s.%d route not updated(No Memory)",
+                       pInput->ictlmgr->device, pInput->input);
+            pInput->nroute = 0;
+            return;
+        }
+        pInput->route = route;
+        pInput->maxroute = num;
+    }
+    num = 0;
+    wl_list_for_each (pSub, &pInput->sub_list, input_link)  {
+        if (pSub->app->resource)    {
+            pInput->route[num++] = pSub->app;
+        }
+    }
+    pInput->nroute = num;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_input_event: coalesce axis input event.
+ *          event of axis switch is merged to latest state, and sent at flush.
+ *          other switch event is not coalesced.
+ *
+ * @param[in]   pInput          Input Switch
+ * @param[in]   time            device input time(miri-sec)
+ * @param[in]   code            input code number
+ * @param[in]   state           input state(axis value)
+ * @param[in]   recvtime        receive time(usec)
+ * @param[in]   delay           input delay(usec, <0=unknown)
+ * @return      coalesced or not
+ * @retval      1               coalesced(send at flush)
+ * @retval      0               not coalesced(send now)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+coalesce_input_event(struct ico_ictl_input *pInput, const uint32_t time,
+                     const int32_t code, const int32_t state,
+                     const uint64_t recvtime, const int delay)
+{
+    if ((pInputMgr->coalesce == 0) ||
+        ((pInput->type & ICO_INPUT_MGR_DEVICE_TYPE_AXIS) == 0)) {
+        return 0;
+    }
+    if ((pInput->pending) && (pInput->pend_code != code))   {
+        /* other code of same switch, send previous state   */
+        coalesce_flush();
+    }
+    pInput->pend_time = time;
+    pInput->pend_code = code;
+    pInput->pend_state = state;
+    pInput->pend_delay = delay;
+    if (! pInput->pending)  {
+        pInput->pending = 1;
+        pInput->pend_recv = recvtime;
+        wl_list_insert(pInputMgr->coalesce_list.prev, &pInput->coalesce_link);
+        coalesce_schedule();
+    }
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_schedule: schedule flush of coalesced events
+ *          (next output frame or flush timer). when flush at output frame,
+ *          fallback timer is also armed, because compositor that sleeps
+ *          (or output that has no damage) does not repaint.
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+coalesce_schedule(void)
+{
+    struct weston_compositor    *ec = pInputMgr->compositor;
+
+    if (pInputMgr->coalesce_armed)  {
+        return;
+    }
+    pInputMgr->coalesce_armed = 1;
+
+    if (pInputMgr->coalesce_rate > 0)   {
+        ico_ivi_timer_arm(&pInputMgr->coalesce_timer,
+                          (1000 + pInputMgr->coalesce_rate - 1) / pInputMgr->coalesce_rate);
+        return;
+    }
+    /* fallback timer, if output frame does not come    */
+    ico_ivi_timer_arm(&pInputMgr->coalesce_timer, ICO_MINPUT_COALESCE_FALLBACK);
+    if (ec->state == WESTON_COMPOSITOR_SLEEPING)    {
+        /* compositor sleeping, flush by timer  */
+        return;
+    }
+    if (! pInputMgr->coalesce_output)   {
+        if (wl_list_empty(&ec->output_list))    {
+            /* no output, flush by timer    */
+            return;
+        }
+        pInputMgr->coalesce_output =
+            container_of(ec->output_list.next, struct weston_output, link);
+        pInputMgr->coalesce_frame.notify = coalesce_frame;
+        wl_signal_add(&pInputMgr->coalesce_output->frame_signal,
+                      &pInputMgr->coalesce_frame);
+        pInputMgr->coalesce_destroy.notify = coalesce_output_destroy;
+        wl_signal_add(&pInputMgr->coalesce_output->destroy_signal,
+                      &pInputMgr->coalesce_destroy);
+    }
+    weston_output_schedule_repaint(pInputMgr->coalesce_output);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_flush: flush coalesced events to applications
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+coalesce_flush(void)
+{
+    struct ico_ictl_input   *pInput;
+    struct ico_ictl_input   *pInputTmp;
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_input_event_rec  rec;
+    int                     i;
+    uifw_watch("input_mgr.coalesce_flush", 0, 0);
+
+    pInputMgr->coalesce_armed = 0;
+    ico_ivi_timer_cancel(&pInputMgr->coalesce_timer);
+
+    /* batched events are sent for each device  */
+    while (! wl_list_empty(&pInputMgr->coalesce_list))  {
+        pIctlMgr = container_of(pInputMgr->coalesce_list.next,
+                                struct ico_ictl_input, coalesce_link)->ictlmgr;
+        wl_list_for_each_safe (pInput, pInputTmp, &pInputMgr->coalesce_list, coalesce_link) {
+            if (pInput->ictlmgr != pIctlMgr)    continue;
+            wl_list_remove(&pInput->coalesce_link);
+            wl_list_init(&pInput->coalesce_link);
+            pInput->pending = 0;
+
+            rec.time = pInput->pend_time;
+            rec.input = pInput->input;
+            rec.code = pInput->pend_code;
+            rec.state = pInput->pend_state;
+            ico_ivi_metric_add(pInputMgr->m_routed, pInput->nroute);
+            for (i = 0; i < pInput->nroute; i++)    {
+                uifw_trace("coalesce_flush: event=%s.%s[%d],%d,%d to App.%s",
+                           pIctlMgr->device, pInput->swname, pInput->input,
+                           pInput->pend_code, pInput->pend_state, pInput->route[i]->appid);
+                if (pInput->pend_delay >= 0)    {
+                    hist_record(&pInput->route[i]->delay, (uint32_t)pInput->pend_delay);
+                }
+                if (batch_add(pIctlMgr->device, pInput->pend_recv,
+                              pInput->route[i], &rec) != ICO_IVI_EOK)   {
+                    uifw_error("coalesce_flush: %s.%d lost(No Memory)",
+                               pIctlMgr->device, pInput->input);
+                }
+            }
+        }
+        batch_send();
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_timer: flush timer of coalesced events
+ *
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+coalesce_timer(void *data)
+{
+    coalesce_flush();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_frame: output frame of flush coalesced events
+ *
+ * @param[in]   listener        frame listener
+ * @param[in]   data            weston output(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+coalesce_frame(struct wl_listener *listener, void *data)
+{
+    if (pInputMgr->coalesce_armed)  {
+        coalesce_flush();
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   coalesce_output_destroy: output of flush every frame destroyed,
+ *          stop listening it and flush pending events(next schedule selects
+ *          other output).
+ *
+ * @param[in]   listener        destroy listener
+ * @param[in]   data            weston output(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+coalesce_output_destroy(struct wl_listener *listener, void *data)
+{
+    uifw_trace("coalesce_output_destroy: output=%08x", (int)pInputMgr->coalesce_output);
+
+    wl_list_remove(&pInputMgr->coalesce_frame.link);
+    wl_list_remove(&pInputMgr->coalesce_destroy.link);
+    pInputMgr->coalesce_output = NULL;
+    if (pInputMgr->coalesce_armed)  {
+        coalesce_flush();
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   gesture_input_event: recognize long-press, auto-repeat and chord
+ *          of switch event, and queue synthesized gesture event to batch
+ *          (called after raw switch event is queued, caller sends batch).
+ *          chord is reported on the switch of lower input number, and its
+ *          code is ICO_EXINPUT_GESTURE_CHORD | higher input number.
+ *
+ * @param[in]   pInput          Input Switch(has gesture)
+ * @param[in]   time            device input time(miri-sec)
+ * @param[in]   code            input code number
+ * @param[in]   state           input state(1=On, 0=Off)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+gesture_input_event(struct ico_ictl_input *pInput, const uint32_t time,
+                    const int32_t code, const int32_t state)
+{
+    struct ico_ictl_gesture *gs = pInput->gesture;
+    struct ico_ictl_gesture *partner = NULL;
+    struct ico_ictl_input   *pPartner = NULL;
+    struct ico_ictl_input   *pLow;
+    struct ico_ictl_input   *pHigh;
+
+    if (gs->chord >= 0) {
+        pPartner = find_ictlinput_by_input(pInput->ictlmgr, gs->chord);
+        if (pPartner)   {
+            partner = pPartner->gesture;
+        }
+    }
+    if ((partner) && (pPartner->input < pInput->input)) {
+        pLow = pPartner;
+        pHigh = pInput;
+    }
+    else    {
+        pLow = pInput;
+        pHigh = pPartner;
+    }
+
+    if (state)  {
+        if (gs->phase != ICO_MINPUT_GESTURE_IDLE)   {
+            /* already pressed          */
+            return;
+        }
+        gs->presstime = time;
+        gs->code = code;
+        gs->longsent = 0;
+
+        if ((partner) && (partner->phase != ICO_MINPUT_GESTURE_IDLE) &&
+            (partner->phase != ICO_MINPUT_GESTURE_CHORD) &&
+            ((int)(time - partner->presstime) <= gs->chord_time))   {
+            /* chord, cancel long-press/auto-repeat of both switchs */
+            ico_ivi_timer_cancel(&partner->timer);
+            partner->phase = ICO_MINPUT_GESTURE_CHORD;
+            gs->phase = ICO_MINPUT_GESTURE_CHORD;
+            gesture_send(pLow, time, ICO_EXINPUT_GESTURE_CHORD | pHigh->input, 1);
+            return;
+        }
+        gs->phase = ICO_MINPUT_GESTURE_PRESS;
+        if (gs->longpress > 0)  {
+            gs->timertime = time + gs->longpress;
+            ico_ivi_timer_arm(&gs->timer, gs->longpress);
+        }
+        else if (gs->repeat_delay > 0)  {
+            gs->phase = ICO_MINPUT_GESTURE_REPEAT;
+            gs->timertime = time + gs->repeat_delay;
+            ico_ivi_timer_arm(&gs->timer, gs->repeat_delay);
+        }
+    }
+    else    {
+        ico_ivi_timer_cancel(&gs->timer);
+        if ((gs->phase == ICO_MINPUT_GESTURE_CHORD) && (partner) &&
+            (partner->phase == ICO_MINPUT_GESTURE_CHORD))   {
+            /* chord released by first release  */
+            partner->phase = ICO_MINPUT_GESTURE_PRESS;
+            gesture_send(pLow, time, ICO_EXINPUT_GESTURE_CHORD | pHigh->input, 0);
+        }
+        else if (gs->longsent)  {
+            gesture_send(pInput, time, ICO_EXINPUT_GESTURE_LONGPRESS | gs->code, 0);
+        }
+        gs->phase = ICO_MINPUT_GESTURE_IDLE;
+        gs->longsent = 0;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   gesture_timer: timer of long-press and auto-repeat.
+ *          event time is pressed time(device clock) plus elapsed delays,
+ *          same clock as raw switch events.
+ *
+ * @param[in]   data            gesture of Input Switch
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+gesture_timer(void *data)
+{
+    struct ico_ictl_gesture *gs = (struct ico_ictl_gesture *)data;
+    uint32_t    time = gs->timertime;
+    int         interval;
+    uifw_watch("input_mgr.gesture_timer", data, 0);
+
+    if ((gs->phase == ICO_MINPUT_GESTURE_PRESS) && (gs->longsent == 0))  {
+        /* long-press                   */
+        gs->longsent = 1;
+        gesture_send(gs->input, time, ICO_EXINPUT_GESTURE_LONGPRESS | gs->code, 1);
+        if (gs->repeat_delay > 0)   {
+            gs->phase = ICO_MINPUT_GESTURE_REPEAT;
+            gs->timertime = time + gs->repeat_delay;
+            ico_ivi_timer_arm(&gs->timer, gs->repeat_delay);
+        }
+    }
+    else if (gs->phase == ICO_MINPUT_GESTURE_REPEAT)    {
+        /* auto-repeat                  */
+        gesture_send(gs->input, time, ICO_EXINPUT_GESTURE_REPEAT | gs->code, 1);
+        interval = (gs->repeat_rate > 0) ?
+                       ((1000 + gs->repeat_rate - 1) / gs->repeat_rate) : gs->repeat_delay;
+        gs->timertime = time + interval;
+        ico_ivi_timer_arm(&gs->timer, interval);
+    }
+    batch_send();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   gesture_send: queue synthesized gesture event to batch of subscribed
+ *          applications, after raw switch events(coalesced raw event is
+ *          flushed first). caller sends batch by batch_send.
+ *
+ * @param[in]   pInput          Input Switch
+ * @param[in]   time            event time(miri-sec)
+ * @param[in]   code            synthesized code(ICO_EXINPUT_GESTURE_xxx | code)
+ * @param[in]   state           state(1=On, 0=Off)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+gesture_send(struct ico_ictl_input *pInput, const uint32_t time,
+             const int32_t code, const int32_t state)
+{
+    struct ico_input_event_rec  rec;
+    uint64_t    recvtime = input_now_usec();
+    int         i;
+
+    if (pInput->pending)    {
+        /* raw event of this switch is coalesced, send it before gesture    */
+        coalesce_flush();
+    }
+    rec.time = time;
+    rec.input = pInput->input;
+    rec.code = code;
+    rec.state = state;
+    ico_ivi_metric_add(pInputMgr->m_routed, pInput->nroute);
+    for (i = 0; i < pInput->nroute; i++)    {
+        uifw_trace("gesture_send: event=%s.%s[%d],%08x,%d to App.%s",
+                   pInput->ictlmgr->device, pInput->swname, pInput->input,
+                   code, state, pInput->route[i]->appid);
+        if (batch_add(pInput->ictlmgr->device, recvtime, pInput->route[i], &rec)
+                != ICO_IVI_EOK) {
+            uifw_error("gesture_send: %s.%d lost(No Memory)",
+                       pInput->ictlmgr->device, pInput->input);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   gesture_create: create gesture of Input Switch
+ *          (if switch not configured yet, create switch table)
+ *
+ * @param[in]   device          device name
+ * @param[in]   input           input switch number
+ * @return      gesture
+ * @retval      !=NULL          gesture of Input Switch
+ * @retval      ==NULL          error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static struct ico_ictl_gesture *
+gesture_create(const char *device, const int input)
+{
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_ictl_input   *pInput = NULL;
+    struct ico_ictl_gesture *gs;
+
+    pIctlMgr = find_ictlmgr_by_device(device);
+    if (pIctlMgr)   {
+        pInput = find_ictlinput_by_input(pIctlMgr, input);
+    }
+    if (! pInput)   {
+        /* not configure input switch, create   */
+        ico_device_configure_input(NULL, NULL, device, 0, NULL, input, NULL, 0);
+        pIctlMgr = find_ictlmgr_by_device(device);
+        if (! pIctlMgr) {
+            return NULL;
+        }
+        pInput = find_ictlinput_by_input(pIctlMgr, input);
+        if (! pInput)   {
+            return NULL;
+        }
+    }
+    if (pInput->gesture)    {
+        return pInput->gesture;
+    }
+
+    gs = (struct ico_ictl_gesture *)malloc(sizeof(struct ico_ictl_gesture));
+    if (! gs)   {
+        return NULL;
+    }
+    memset(gs, 0, sizeof(struct ico_ictl_gesture));
+    gs->input = pInput;
+    gs->chord = -1;
+    gs->chord_time = ICO_MINPUT_CHORD_TIME;
+    gs->raw = 1;
+    /* timer wheel of ico_ivi_common, no event source for each switch   */
+    ico_ivi_timer_init(&gs->timer, gesture_timer, gs);
+    pInput->gesture = gs;
+    return gs;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   gesture_config: set gesture of Input Switch from configuration
+ *          (called at end of each [input_gesture] section).
+ *          chord partner switch also gets chord to this switch.
+ *
+ * @param[in]   data            configuration(ico_input_conf)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+gesture_config(void *data)
+{
+    struct ico_gesture_conf *conf = ((struct ico_input_conf *)data)->gesture;
+    struct ico_ictl_gesture *gs;
+    struct ico_ictl_gesture *partner;
+
+    if ((! conf->device) || (conf->input < 0))  {
+        uifw_warn("gesture_config: [input_gesture] needs device and input");
+        goto out;
+    }
+    uifw_trace("gesture_config: Enter(%s.%d long=%d repeat=%d/%d chord=%d/%d raw=%d)",
+               conf->device, conf->input, conf->longpress, conf->repeat_delay,
+               conf->repeat_rate, conf->chord, conf->chord_time, conf->raw);
+
+    gs = gesture_create(conf->device, conf->input);
+    if (! gs)   {
+        uifw_error("gesture_config: Leave(No Memory)");
+        goto out;
+    }
+    gs->longpress = conf->longpress;
+    gs->repeat_delay = conf->repeat_delay;
+    gs->repeat_rate = conf->repeat_rate;
+    gs->chord = conf->chord;
+    gs->chord_time = conf->chord_time;
+    gs->raw = conf->raw;
+
+    if ((conf->chord >= 0) && (conf->chord != conf->input)) {
+        partner = gesture_create(conf->device, conf->chord);
+        if (! partner)  {
+            uifw_error("gesture_config: %s.%d chord partner not created(No Memory)",
+                       conf->device, conf->chord);
+            gs->chord = -1;
+        }
+        else    {
+            partner->chord = conf->input;
+            partner->chord_time = conf->chord_time;
+        }
+    }
+    uifw_trace("gesture_config: Leave");
+
+out:
+    free(conf->device);
+    memset(conf, 0, sizeof(struct ico_gesture_conf));
+    conf->chord = -1;
+    conf->chord_time = ICO_MINPUT_CHORD_TIME;
+    conf->raw = 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   store_load: load input switchs and fixed assigns from store file,
+ *          routing of fixed assign is ready before HomeScreen connects.
+ *          store file is text, first line is version, and each record is
+ *          tab separated fields.
+ *              D <device> <type>
+ *              S <device> <input> <type> <swname> <code> <codename>
+ *              C <device> <input> <code> <codename>
+ *              F <appid> <device> <input> <flags>
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+store_load(void)
+{
+    FILE    *fp;
+    char    line[ICO_MINPUT_STORE_LINE];
+    char    *field[ICO_MINPUT_STORE_FIELDS];
+    int     nfield;
+    int     version;
+    int     nrec = 0;
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_ictl_input   *pInput;
+    struct ico_app_mgr      *pAppMgr;
+
+    uifw_trace("store_load: Enter(%s)", pInputMgr->store);
+
+    fp = fopen(pInputMgr->store, "r");
+    if (! fp)   {
+        uifw_trace("store_load: Leave(%s not exist)", pInputMgr->store);
+        return;
+    }
+    if ((! fgets(line, sizeof(line), fp)) ||
+        (sscanf(line, "#ico_input_mgr %d", &version) != 1) ||
+        (version != ICO_MINPUT_STORE_VERSION))   {
+        uifw_warn("store_load: Leave(%s is not version %d)",
+                  pInputMgr->store, ICO_MINPUT_STORE_VERSION);
+        fclose(fp);
+        return;
+    }
+
+    while (fgets(line, sizeof(line), fp))   {
+        nfield = store_split(line, field);
+        if (nfield <= 0)    continue;
+
+        if ((strcmp(field[0], "D") == 0) && (nfield >= 3))  {
+            pIctlMgr = find_ictlmgr_by_device(field[1]);
+            if ((pIctlMgr) && (! pIctlMgr->evdev))  {
+                pIctlMgr->type = strtol(field[2], (char **)0, 0);
+            }
+        }
+        else if ((strcmp(field[0], "S") == 0) && (nfield >= 7)) {
+            pIctlMgr = find_ictlmgr_by_device(field[1]);
+            if ((pIctlMgr) && (pIctlMgr->evdev))    continue;
+            ico_device_configure_input(NULL, NULL, field[1], strtol(field[3], (char **)0, 0),
+                                       field[4], strtol(field[2], (char **)0, 0),
+                                       field[6], strtol(field[5], (char **)0, 0));
+        }
+        else if ((strcmp(field[0], "C") == 0) && (nfield >= 5)) {
+            pIctlMgr = find_ictlmgr_by_device(field[1]);
+            if ((! pIctlMgr) || (pIctlMgr->evdev))  continue;
+            ico_device_configure_code(NULL, NULL, field[1], strtol(field[2], (char **)0, 0),
+                                      field[4], strtol(field[3], (char **)0, 0));
+        }
+        else if ((strcmp(field[0], "F") == 0) && (nfield >= 5)) {
+            pIctlMgr = find_ictlmgr_by_device(field[2]);
+            if (! pIctlMgr) continue;
+            pInput = find_ictlinput_by_input(pIctlMgr, strtol(field[3], (char **)0, 0));
+            if (! pInput)   continue;
+            pAppMgr = find_app_by_appid(field[1]);
+            if (! pAppMgr)  {
+                pAppMgr = create_app_mgr(field[1]);
+                if (! pAppMgr)  {
+                    uifw_error("store_load: App.%s not created(No Memory)", field[1]);
+                    continue;
+                }
+            }
+            if (subscribe_input_app(pInput, pAppMgr, strtoul(field[4], (char **)0, 0))
+                    != ICO_IVI_EOK) {
+                uifw_warn("store_load: %s.%d can not assign to App.%s",
+                          field[2], pInput->input, field[1]);
+                continue;
+            }
+        }
+        else    {
+            continue;
+        }
+        nrec ++;
+    }
+    fclose(fp);
+    uifw_info("store_load: %d records loaded from %s", nrec, pInputMgr->store);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   store_schedule: schedule write of store file,
+ *          changes of short time are written at once.
+ *
+ * @param       none
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+store_schedule(void)
+{
+    if (pInputMgr->store_timer.func)    {
+        /* not store or loading, store timer is not initialized */
+        ico_ivi_timer_arm(&pInputMgr->store_timer, ICO_MINPUT_STORE_DELAY);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   store_write: write input switchs and fixed assigns to store file.
+ *          write to temporary file, sync it and rename it, store file is always
+ *          complete(also at power off).
+ *          switchs and assigns that name has tab or newline are not stored.
+ *
+ * @param[in]   data            user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+store_write(void *data)
+{
+    FILE    *fp;
+    char    tmpname[ICO_MINPUT_STORE_LINE];
+    int     i;
+    int     ret;
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_ictl_input   *pInput;
+    struct ico_app_mgr      *pAppMgr;
+    struct ico_ictl_sub     *pSub;
+    uifw_watch("input_mgr.store_write", 0, 0);
+
+    uifw_trace("store_write: Enter(%s)", pInputMgr->store);
+
+    if (snprintf(tmpname, sizeof(tmpname), "%s.tmp", pInputMgr->store)
+            >= (int)sizeof(tmpname))    {
+        uifw_warn("store_write: Leave(%s name too long)", pInputMgr->store);
+        return;
+    }
+    fp = fopen(tmpname, "w");
+    if (! fp)   {
+        uifw_warn("store_write: Leave(%s open error[%d])", tmpname, errno);
+        return;
+    }
+    fprintf(fp, "#ico_input_mgr %d\n", ICO_MINPUT_STORE_VERSION);
+
+    wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
+        wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
+            if ((! store_field(pIctlMgr->device)) || (! store_field(pInput->swname)) ||
+                (! store_field(pInput->code[0].name)))  {
+                uifw_warn("store_write: %s.%d not stored(name has tab/newline)",
+                          pIctlMgr->device, pInput->input);
+                continue;
+            }
+            fprintf(fp, "S\t%s\t%d\t%d\t%s\t%d\t%s\n", pIctlMgr->device,
+                    pInput->input, pInput->type, pInput->swname,
+                    pInput->code[0].code, pInput->code[0].name);
+            for (i = 1; i < pInput->ncode; i++) {
+                if (! store_field(pInput->code[i].name))    continue;
+                fprintf(fp, "C\t%s\t%d\t%d\t%s\n", pIctlMgr->device,
+                        pInput->input, pInput->code[i].code, pInput->code[i].name);
+            }
+        }
+        /* device type after switchs, switch configure changes device type  */
+        if (! store_field(pIctlMgr->device))    continue;
+        fprintf(fp, "D\t%s\t%d\n", pIctlMgr->device, pIctlMgr->type);
+    }
+    wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
+        wl_list_for_each (pSub, &pAppMgr->input_list, app_link) {
+            if ((pSub->flags & ICO_INPUT_MGR_CONTROL_ASSIGN_FIX) == 0)  continue;
+            if ((! store_field(pAppMgr->appid)) ||
+                (! store_field(pSub->input->ictlmgr->device)))  {
+                uifw_warn("store_write: App.%s assign not stored(name has tab/newline)",
+                          pAppMgr->appid);
+                continue;
+            }
+            fprintf(fp, "F\t%s\t%s\t%d\t%d\n", pAppMgr->appid,
+                    pSub->input->ictlmgr->device, pSub->input->input, pSub->flags);
+        }
+    }
+
+    ret = fflush(fp);
+    if ((ret == 0) && (fsync(fileno(fp)) != 0)) {
+        ret = -1;
+    }
+    if (fclose(fp) != 0)    {
+        ret = -1;
+    }
+    if ((ret != 0) || (rename(tmpname, pInputMgr->store) != 0))  {
+        uifw_warn("store_write: Leave(%s write error[%d])", pInputMgr->store, errno);
+        unlink(tmpname);
+        return;
+    }
+    uifw_trace("store_write: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   store_split: split record of store file to fields
+ *
+ * @param[in]   line            record(tab separated, changed to fields)
+ * @param[out]  field           fields
+ * @return      number of fields
+ */
+/*--------------------------------------------------------------------------*/
+static int
+store_split(char *line, char **field)
+{
+    int     nfield = 0;
+    char    *p = line;
+
+    if ((*line == '#') || (*line == '\n') || (*line == 0)) {
+        /* comment or empty line        */
+        return 0;
+    }
+    while (nfield < ICO_MINPUT_STORE_FIELDS)    {
+        field[nfield++] = p;
+        while ((*p != '\t') && (*p != '\n') && (*p != 0)) p++;
+        if (*p != '\t')    {
+            *p = 0;
+            break;
+        }
+        *p++ = 0;
+    }
+    return nfield;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   store_field: check field of store file(tab and newline are separator)
+ *
+ * @param[in]   name            field string
+ * @return      result
+ * @retval      1               can store
+ * @retval      0               can not store(has tab or newline)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+store_field(const char *name)
+{
+    return (strpbrk(name, "\t\r\n") == NULL) ? 1 : 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   evdev_config: create evdev device from configuration
+ *          (called at end of each [input_device] section).
+ *          switch map is "swname,input,evtype,evcode[,code];...",
+ *          code is input code number(default evcode).
+ *
+ * @param[in]   data            configuration(ico_input_conf)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+evdev_config(void *data)
+{
+    struct ico_evdev_conf   *conf = ((struct ico_input_conf *)data)->evdev;
+    struct ico_evdev        *evdev = NULL;
+    struct ico_evdev_map    *map;
+    char    *entry;
+    char    *saveentry;
+    char    *field[5];
+    char    *savefield;
+    int     nfield;
+    int     i;
+
+    if ((! conf->name) || (! conf->path) || (! conf->switches)) {
+        uifw_warn("evdev_config: [input_device] needs name, path and switch");
+        goto out;
+    }
+    uifw_trace("evdev_config: Enter(name=%s,path=%s,type=%d)",
+               conf->name, conf->path, conf->type);
+
+    evdev = (struct ico_evdev *)malloc(sizeof(struct ico_evdev));
+    if (! evdev)    {
+        uifw_error("evdev_config: Leave(No Memory)");
+        goto out;
+    }
+    memset(evdev, 0, sizeof(struct ico_evdev));
+    evdev->fd = -1;
+    strncpy(evdev->path, conf->path, sizeof(evdev->path)-1);
+    ico_ivi_timer_init(&evdev->reopen, evdev_reopen, evdev);
+
+    for (entry = strtok_r(conf->switches, ";", &saveentry); entry != NULL;
+         entry = strtok_r(NULL, ";", &saveentry))   {
+        nfield = 0;
+        for (field[0] = strtok_r(entry, ",", &savefield); field[nfield] != NULL;
+             field[nfield] = strtok_r(NULL, ",", &savefield))   {
+            if (++nfield >= 5)  break;
+        }
+        if ((nfield < 4) || (evdev->nmap >= ICO_MINPUT_EVDEV_MAXMAP))   {
+            uifw_warn("evdev_config: %s illegal switch map(%s)", conf->name, entry);
+            continue;
+        }
+        map = &evdev->map[evdev->nmap];
+        map->input = strtol(field[1], (char **)0, 0);
+        map->evtype = strtol(field[2], (char **)0, 0);
+        map->evcode = strtol(field[3], (char **)0, 0);
+        map->code = (nfield >= 5) ? strtol(field[4], (char **)0, 0) : map->evcode;
+
+        /* create input switch(first map of switch) or add code */
+        for (i = 0; i < evdev->nmap; i++)   {
+            if (evdev->map[i].input == map->input)  break;
+        }
+        if (i >= evdev->nmap)   {
+            ico_device_configure_input(NULL, NULL, conf->name, conf->type, field[0],
+                                       map->input, field[0], map->code);
+        }
+        else    {
+            ico_device_configure_code(NULL, NULL, conf->name, map->input,
+                                      field[0], map->code);
+        }
+        evdev->nmap ++;
+    }
+    evdev->ictlmgr = find_ictlmgr_by_device(conf->name);
+    if ((evdev->nmap <= 0) || (! evdev->ictlmgr))   {
+        uifw_warn("evdev_config: Leave(%s no switch)", conf->name);
+        free(evdev);
+        goto out;
+    }
+    evdev->ictlmgr->evdev = evdev;
+    if (conf->type) {
+        evdev->ictlmgr->type = conf->type;
+    }
+    wl_list_insert(pInputMgr->evdev_list.prev, &evdev->link);
+    uifw_trace("evdev_config: Leave(%s %d maps)", conf->name, evdev->nmap);
+
+out:
+    free(conf->name);
+    free(conf->path);
+    free(conf->switches);
+    memset(conf, 0, sizeof(struct ico_evdev_conf));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   evdev_open: open evdev device and regist to event loop.
+ *          path "fd:N" is already opened file descriptor N(ex. pipe for test).
+ *
+ * @param[in]   evdev           evdev device
+ * @return      result
+ * @retval      ICO_IVI_EOK     success
+ * @retval      ICO_IVI_EIO     error(open error or illegal fd:N)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+evdev_open(struct ico_evdev *evdev)
+{
+    int     flags;
+
+    if (strncmp(evdev->path, "fd:", 3) == 0)    {
+        evdev->fd = strtol(&evdev->path[3], (char **)0, 0);
+        flags = fcntl(evdev->fd, F_GETFL);
+        if ((flags < 0) || (fcntl(evdev->fd, F_SETFL, flags | O_NONBLOCK) < 0))    {
+            uifw_error("evdev_open: %s(%s) illegal fd[%d]",
+                       evdev->ictlmgr->device, evdev->path, errno);
+            evdev->fd = -1;
+            return ICO_IVI_EIO;
+        }
+    }
+    else    {
+        evdev->fd = open(evdev->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    }
+    if (evdev->fd < 0)  {
+        return ICO_IVI_EIO;
+    }
+    evdev->len = 0;
+    evdev->source = wl_event_loop_add_fd(
+                        wl_display_get_event_loop(pInputMgr->compositor->wl_display),
+                        evdev->fd, WL_EVENT_READABLE, evdev_dispatch, evdev);
+    if (! evdev->source)    {
+        close(evdev->fd);
+        evdev->fd = -1;
+        return ICO_IVI_EIO;
+    }
+    uifw_info("evdev_open: %s(%s) fd=%d", evdev->ictlmgr->device, evdev->path, evdev->fd);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   evdev_dispatch: read evdev device and send switch event
+ *          through same routing as input event from Input Controller.
+ *          at end of file or read error, device is closed and re-opened
+ *          (retry every ICO_MINPUT_EVDEV_REOPEN ms until device returns).
+ *          "fd:N" device is not re-opened, dropped.
+ *
+ * @param[in]   fd              file descriptor
+ * @param[in]   mask            event mask(unused)
+ * @param[in]   data            evdev device
+ * @return      always 1
+ */
+/*--------------------------------------------------------------------------*/
+static int
+evdev_dispatch(int fd, uint32_t mask, void *data)
+{
+    struct ico_evdev    *evdev = (struct ico_evdev *)data;
+    struct input_event  *ev;
+    int     len;
+    int     pos;
+    int     i;
+    uifw_watch("input_mgr.evdev_dispatch", fd, mask);
+
+    for (;;)    {
+        len = read(fd, &evdev->buf[evdev->len], sizeof(evdev->buf) - evdev->len);
+        if (len <= 0)   {
+            if ((len < 0) && ((errno == EAGAIN) || (errno == EINTR)))   break;
+
+            /* end of file or error, close(and re-open if path)    */
+            if (len == 0)   {
+                uifw_warn("evdev_dispatch: %s(%s) end of file",
+                          evdev->ictlmgr->device, evdev->path);
+            }
+            else    {
+                uifw_warn("evdev_dispatch: %s(%s) read error[%d]",
+                          evdev->ictlmgr->device, evdev->path, errno);
+            }
+            wl_event_source_remove(evdev->source);
+            evdev->source = NULL;
+            close(evdev->fd);
+            evdev->fd = -1;
+            if (strncmp(evdev->path, "fd:", 3) == 0)    {
+                uifw_warn("evdev_dispatch: %s(%s) dropped",
+                          evdev->ictlmgr->device, evdev->path);
+            }
+            else if (evdev_open(evdev) != ICO_IVI_EOK)  {
+                uifw_warn("evdev_dispatch: %s(%s) re-open error[%d], retry",
+                          evdev->ictlmgr->device, evdev->path, errno);
+                ico_ivi_timer_arm(&evdev->reopen, ICO_MINPUT_EVDEV_REOPEN);
+            }
+            break;
+        }
+        evdev->len += len;
+
+        /* event may be divided(pipe), process only whole events */
+        for (pos = 0; (evdev->len - pos) >= (int)sizeof(struct input_event);
+             pos += sizeof(struct input_event)) {
+            ev = (struct input_event *)&evdev->buf[pos];
+            if ((ev->type == EV_SYN) ||
+                ((ev->type == EV_KEY) && (ev->value == 2))) {
+                /* synchronize and key repeat are not used  */
+                continue;
+            }
+            for (i = 0; i < evdev->nmap; i++)   {
+                if ((evdev->map[i].evtype == ev->type) &&
+                    (evdev->map[i].evcode == ev->code)) break;
+            }
+            if (i >= evdev->nmap)   continue;
+
+            ico_device_input_event(NULL, NULL,
+                                   (uint32_t)ev->time.tv_sec * 1000u +
+                                       (uint32_t)(ev->time.tv_usec / 1000),
+                                   evdev->ictlmgr->device, evdev->map[i].input,
+                                   evdev->map[i].code, ev->value);
+        }
+        if (pos > 0)    {
+            evdev->len -= pos;
+            memmove(evdev->buf, &evdev->buf[pos], evdev->len);
+        }
+    }
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   evdev_reopen: retry re-open of evdev device(device node removed)
+ *
+ * @param[in]   data            evdev device
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+evdev_reopen(void *data)
+{
+    struct ico_evdev    *evdev = (struct ico_evdev *)data;
+    uifw_watch("input_mgr.evdev_reopen", data, 0);
+
+    if (evdev_open(evdev) != ICO_IVI_EOK)   {
+        uifw_trace("evdev_reopen: %s(%s) open error[%d], retry",
+                   evdev->ictlmgr->device, evdev->path, errno);
+        ico_ivi_timer_arm(&evdev->reopen, ICO_MINPUT_EVDEV_REOPEN);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_put_uint: put 32bits value to capability record
+ *
+ * @param[out]  array           capability record
+ * @param[in]   value           value
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+cap_put_uint(struct wl_array *array, const uint32_t value)
+{
+    uint32_t    *p;
+
+    p = (uint32_t *)wl_array_add(array, sizeof(uint32_t));
+    if (! p)    {
+        return -1;
+    }
+    *p = value;
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_put_string: put string to capability record
+ *          (length with NULL terminate, and string padded to 32bits)
+ *
+ * @param[out]  array           capability record
+ * @param[in]   str             string
+ * @return      result
+ * @retval      0               success
+ * @retval      -1              error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+cap_put_string(struct wl_array *array, const char *str)
+{
+    int     len = strlen(str) + 1;
+    int     size = (len + 3) & (~3);
+    char    *p;
+
+    if (cap_put_uint(array, len) < 0)   {
+        return -1;
+    }
+    p = (char *)wl_array_add(array, size);
+    if (! p)    {
+        return -1;
+    }
+    memset(p, 0, size);
+    memcpy(p, str, len);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_serialize: serialize capability of input switch.
+ *          record is (size, input, type, ncode, device, swname,
+ *          ncode * (code, codename)), string is (length, padded string).
+ *
+ * @param[in]   pInput          Input Switch
+ * @return      result
+ * @retval      ICO_IVI_EOK     success
+ * @retval      ICO_IVI_ENOMEM  error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+cap_serialize(struct ico_ictl_input *pInput)
+{
+    struct wl_array *cap = &pInput->cap;
+    int     i;
+    int     err;
+
+    if (cap->size > 0)  {
+        /* not changed                  */
+        return ICO_IVI_EOK;
+    }
+    err = cap_put_uint(cap, 0);
+    err |= cap_put_uint(cap, pInput->input);
+    err |= cap_put_uint(cap, pInput->ictlmgr->type);
+    err |= cap_put_uint(cap, pInput->ncode);
+    err |= cap_put_string(cap, pInput->ictlmgr->device);
+    err |= cap_put_string(cap, pInput->swname);
+    for (i = 0; i < pInput->ncode; i++) {
+        err |= cap_put_uint(cap, pInput->code[i].code);
+        err |= cap_put_string(cap, pInput->code[i].name);
+    }
+    if (err)    {
+        cap->size = 0;
+        return ICO_IVI_ENOMEM;
+    }
+    *((uint32_t *)cap->data) = cap->size;
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_get_table: get capability table for application.
+ *          common table is rebuilt only after configuration changed, and
+ *          if application can not receive some switch(fixed assign to other
+ *          application), filtered table is made from serialized switchs.
+ *
+ * @param[in]   pAppMgr         application
+ * @return      capability table
+ * @retval      !=NULL          capability table
+ * @retval      ==NULL          error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static struct wl_array *
+cap_get_table(struct ico_app_mgr *pAppMgr)
+{
+    struct ico_ictl_mgr     *pIctlMgr;
+    struct ico_ictl_input   *pInput;
+    struct wl_array         *table;
+    void                    *p;
+    int                     filter = 0;
+
+    /* check switchs fixed assign to other application  */
+    wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
+        if (! ICTL_INITIALIZED(pIctlMgr))   continue;
+        wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
+            if ((pInput->swname[0] != 0) && (input_fixed_other(pInput, pAppMgr)))  {
+                filter = 1;
+                break;
+            }
+        }
+        if (filter) break;
+    }
+    if ((filter == 0) && (pInputMgr->cap_dirty == 0))   {
+        /* common table is valid        */
+        return &pInputMgr->cap_table;
+    }
+
+    table = filter ? &pInputMgr->cap_work : &pInputMgr->cap_table;
+    table->size = 0;
+    wl_list_for_each (pIctlMgr, &pInputMgr->ictl_list, link)    {
+        if (! ICTL_INITIALIZED(pIctlMgr))   continue;
+        wl_list_for_each (pInput, &pIctlMgr->ico_ictl_input, link)  {
+            if (pInput->swname[0] == 0) continue;
+            if ((filter) && (input_fixed_other(pInput, pAppMgr)))   continue;
+            if (cap_serialize(pInput) != ICO_IVI_EOK)   {
+                return NULL;
+            }
+            p = wl_array_add(table, pInput->cap.size);
+            if (! p)    {
+                return NULL;
+            }
+            memcpy(p, pInput->cap.data, pInput->cap.size);
+        }
+    }
+    if (! filter)   {
+        pInputMgr->cap_dirty = 0;
+    }
+    return table;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_change: capability table changed, update version of table.
+ *          version is updated once for each change.
+ *
+ * @param[in]   whole           difference of one switch is not enough(1=yes)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+cap_change(const int whole)
+{
+    pInputMgr->cap_version ++;
+    pInputMgr->cap_dirty = 1;
+    if (whole)  {
+        /* applications of previous version receive whole table */
+        pInputMgr->cap_whole = pInputMgr->cap_version;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   cap_send_change: send capability change of input switch to
+ *          applications which use capability table. application which
+ *          has previous version receives difference, others receive
+ *          whole table.
+ *
+ * @param[in]   pIctlMgr        Input Controller device
+ * @param[in]   pInput          changed Input Switch
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+cap_send_change(struct ico_ictl_mgr *pIctlMgr, struct ico_ictl_input *pInput)
+{
+    struct ico_app_mgr      *pAppMgr;
+    struct wl_array         *table;
+    struct wl_array         empty;
+
+    if (cap_serialize(pInput) != ICO_IVI_EOK)   {
+        uifw_error("cap_send_change: %s.%d not serialized(No Memory)",
+                   pIctlMgr->device, pInput->input);
+        return;
+    }
+    wl_array_init(&empty);
+
+    wl_list_for_each (pAppMgr, &pInputMgr->app_list, link)  {
+        if (pAppMgr->resource == NULL)  continue;
+        if (pAppMgr->version < ICO_MINPUT_EXINPUT_CAPTABLE) continue;
+
+        if ((pAppMgr->cap_version == (pInputMgr->cap_version - 1)) &&
+            (pInputMgr->cap_whole != pInputMgr->cap_version))   {
+            /* send difference              */
+            uifw_trace("cap_send_change: send difference to app(%s) %s.%s[%d]",
+                       pAppMgr->appid, pIctlMgr->device, pInput->swname, pInput->input);
+            ico_exinput_send_capability_table(pAppMgr->resource, pInputMgr->cap_version,
+                                              pAppMgr->cap_version,
+                                              input_fixed_other(pInput, pAppMgr) ?
+                                                  &empty : &pInput->cap);
+        }
+        else    {
+            /* send whole table             */
+            table = cap_get_table(pAppMgr);
+            if (! table)    {
+                uifw_error("cap_send_change: table not created(No Memory)");
+                continue;
+            }
+            uifw_trace("cap_send_change: send table to app(%s)", pAppMgr->appid);
+            ico_exinput_send_capability_table(pAppMgr->resource, pInputMgr->cap_version,
+                                              0, table);
+        }
+        pAppMgr->cap_version = pInputMgr->cap_version;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   input_now_usec: current time of day(micro-sec)
+ *
+ * @param       none
+ * @return      current time(micro-sec)
+ */
+/*--------------------------------------------------------------------------*/
+static uint64_t
+input_now_usec(void)
+{
+    struct timeval  nowtv;
+
+    gettimeofday(&nowtv, NULL);
+    return ((uint64_t)nowtv.tv_sec) * 1000000 + nowtv.tv_usec;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   input_delay: record input delay of device event
+ *          (device input time to receive by this manager).
+ *          Input time is gettimeofday epoch milli-sec truncated to 32 bits
+ *          (same clock as evdev).
+ *
+ * @param[in]   pIctlMgr        Input Controller device
+ * @param[in]   time            device input time(milli-sec)
+ * @param[in]   recvtime        receive time(micro-sec)
+ * @return      input delay
+ * @retval      >= 0            input delay(micro-sec)
+ * @retval      < 0             input time not synchronized to this manager
+ */
+/*--------------------------------------------------------------------------*/
+static int
+input_delay(struct ico_ictl_mgr *pIctlMgr, const uint32_t time, const uint64_t recvtime)
+{
+    int32_t     delay;
+
+    delay = (int32_t)((uint32_t)(recvtime / 1000) - time);
+    if (delay < 0)  {
+        /* clock of device is a little ahead    */
+        delay = 0;
+    }
+    else if (delay > ICO_MINPUT_DELAY_MAX)  {
+        pIctlMgr->unsync ++;
+        return -1;
+    }
+    delay *= 1000;
+    hist_record(&pIctlMgr->delay, (uint32_t)delay);
+    return delay;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hist_record: add sample to latency histogram
+ *
+ * @param[in]   hist            latency histogram
+ * @param[in]   usec            latency(micro-sec)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+hist_record(struct ico_input_hist *hist, const uint32_t usec)
+{
+    int     idx;
+
+    /* bucket n counts 2^(n-1) <= usec < 2^n    */
+    idx = (usec == 0) ? 0 : (32 - __builtin_clz(usec));
+    if (idx >= ICO_MINPUT_HIST_BUCKETS) {
+        idx = ICO_MINPUT_HIST_BUCKETS - 1;
+    }
+    hist->bucket[idx] ++;
+    hist->count ++;
+    if (usec > hist->max)   {
+        hist->max = usec;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   hist_percentile: percentile of latency histogram
+ *          (upper bound of bucket, but not over maximum latency)
+ *
+ * @param[in]   hist            latency histogram
+ * @param[in]   percent         percentile(1-100)
+ * @return      latency(micro-sec)
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+hist_percentile(const struct ico_input_hist *hist, const int percent)
+{
+    uint64_t    rank;
+    uint64_t    sum = 0;
+    uint32_t    usec;
+    int         idx;
+
+    if (hist->count == 0)   {
+        return 0;
+    }
+    rank = ((uint64_t)hist->count * percent + 99) / 100;
+    for (idx = 0; idx < (ICO_MINPUT_HIST_BUCKETS - 1); idx++)   {
+        sum += hist->bucket[idx];
+        if (sum >= rank)    break;
+    }
+    usec = (idx >= (ICO_MINPUT_HIST_BUCKETS - 1)) ? hist->max : ((1U << idx) - 1);
+    return (usec > hist->max) ? hist->max : usec;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_init: initialization of this plugin
+ *
+ * @param[in]   ec          weston compositor
+ * @return      result
+ * @retval      0           OK
+ * @retval      -1          error
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+module_init(struct weston_compositor *ec)
+{
+    int     coalesce = 0;
+    int     coalesce_rate = ICO_MINPUT_COALESCE_RATE;
+    char    *store = NULL;
+    struct ico_evdev_conf   evconf;
+    struct ico_gesture_conf gsconf;
+    struct ico_evdev        *evdev;
+    struct ico_input_conf   conf = { &evconf, &gsconf };
+
+    struct config_key input_keys[] = {
+        { "coalesce",       CONFIG_KEY_INTEGER, &coalesce },
+        { "coalesce_rate",  CONFIG_KEY_INTEGER, &coalesce_rate },
+        { "store",          CONFIG_KEY_STRING, &store },
+    };
+
+    struct config_key evdev_keys[] = {
+        { "name",           CONFIG_KEY_STRING, &evconf.name },
+        { "path",           CONFIG_KEY_STRING, &evconf.path },
+        { "type",           CONFIG_KEY_INTEGER, &evconf.type },
+        { "switch",         CONFIG_KEY_STRING, &evconf.switches },
+    };
+
+    struct config_key gesture_keys[] = {
+        { "device",         CONFIG_KEY_STRING, &gsconf.device },
+        { "input",          CONFIG_KEY_INTEGER, &gsconf.input },
+        { "longpress",      CONFIG_KEY_INTEGER, &gsconf.longpress },
+        { "repeat_delay",   CONFIG_KEY_INTEGER, &gsconf.repeat_delay },
+        { "repeat_rate",    CONFIG_KEY_INTEGER, &gsconf.repeat_rate },
+        { "chord",          CONFIG_KEY_INTEGER, &gsconf.chord },
+        { "chord_time",     CONFIG_KEY_INTEGER, &gsconf.chord_time },
+        { "raw",            CONFIG_KEY_INTEGER, &gsconf.raw },
+    };
+
+    struct config_section cs[] = {
+        { "input", input_keys, ARRAY_LENGTH(input_keys), NULL },
+        { "input_device", evdev_keys, ARRAY_LENGTH(evdev_keys), evdev_config },
+        { "input_gesture", gesture_keys, ARRAY_LENGTH(gesture_keys), gesture_config },
+    };
+
+    uifw_trace("ico_input_mgr: Enter(module_init)");
+
+    /* initialize management table */
+    pInputMgr = (struct ico_input_mgr *)malloc(sizeof(struct ico_input_mgr));
+    if (pInputMgr == NULL) {
+        uifw_trace("ico_input_mgr: malloc failed");
+        return -1;
+    }
+    memset(pInputMgr, 0, sizeof(struct ico_input_mgr));
+    pInputMgr->compositor = ec;
+
+    /* initialize list */
+    wl_list_init(&pInputMgr->ictl_list);
+    wl_list_init(&pInputMgr->app_list);
+    wl_list_init(&pInputMgr->batch_list);
+    pInputMgr->m_routed = ico_ivi_metric_regist("input_mgr.events_routed",
+                                                ICO_IVI_METRIC_COUNTER);
+    wl_list_init(&pInputMgr->evdev_list);
+    wl_array_init(&pInputMgr->cap_table);
+    wl_array_init(&pInputMgr->cap_work);
+    pInputMgr->cap_version = 1;
+    pInputMgr->cap_dirty = 1;
+
+    /* read configuration(and create evdev devices)    */
+    memset(&evconf, 0, sizeof(evconf));
+    memset(&gsconf, 0, sizeof(gsconf));
+    gsconf.chord = -1;
+    gsconf.chord_time = ICO_MINPUT_CHORD_TIME;
+    gsconf.raw = 1;
+    ico_ivi_conf_parse(cs, ARRAY_LENGTH(cs), &conf);
+
+    pInputMgr->coalesce = coalesce;
+    pInputMgr->coalesce_rate = (coalesce_rate > 0) ? coalesce_rate : 0;
+    wl_list_init(&pInputMgr->coalesce_list);
+    ico_ivi_timer_init(&pInputMgr->coalesce_timer, coalesce_timer, NULL);
+    uifw_info("ico_input_mgr: coalesce=%d rate=%d", coalesce, pInputMgr->coalesce_rate);
+
+    /* load switchs and fixed assigns, after that save changes  */
+    if ((store != NULL) && (*store != 0))   {
+        pInputMgr->store = store;
+        store_load();
+        ico_ivi_timer_init(&pInputMgr->store_timer, store_write, NULL);
+    }
+    else    {
+        free(store);
+    }
+
+    /* interface to desktop manager(ex.HomeScreen)  */
+    if (wl_display_add_global(ec->wl_display,
+                              &ico_input_mgr_control_interface,
+                              pInputMgr,
+                              ico_control_bind) == NULL) {
+        uifw_trace("ico_input_mgr: wl_display_add_global mgr failed");
+        return -1;
+    }
+
+    /* interface to Input Controller(ictl) */
+    if (wl_display_add_global(ec->wl_display,
+                              &ico_input_mgr_device_interface,
+                              pInputMgr,
+                              ico_device_bind) == NULL) {
+        uifw_trace("ico_input_mgr: wl_display_add_global ictl failed");
+        return -1;
     }
 
     /* interface to App(exinput) */
@@ -959,9 +3213,17 @@ module_init(struct weston_compositor *ec)
         return -1;
     }
 
-    /* initialize list */
-    wl_list_init(&pInputMgr->ictl_list);
-    wl_list_init(&pInputMgr->app_list);
+    /* start read evdev devices  */
+    wl_list_for_each (evdev, &pInputMgr->evdev_list, link)  {
+        if (evdev_open(evdev) != ICO_IVI_EOK)   {
+            uifw_warn("ico_input_mgr: evdev %s(%s) open error",
+                      evdev->ictlmgr->device, evdev->path);
+            if (strncmp(evdev->path, "fd:", 3) != 0)    {
+                /* device node may appear later */
+                ico_ivi_timer_arm(&evdev->reopen, ICO_MINPUT_EVDEV_REOPEN);
+            }
+        }
+    }
 
     uifw_trace("ico_input_mgr: Leave(module_init)");
     return 0;
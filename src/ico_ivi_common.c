@@ -35,9 +35,21 @@
 #include <string.h>
 #include <unistd.h>
 #include <dlfcn.h>
+#include <ctype.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
 
 #include <weston/compositor.h>
 #include "ico_ivi_common.h"
+#include "ico_ivi_metrics-server-protocol.h"
 
 /* IVI Plugin Common Table                  */
 struct ico_ivi_common {
@@ -53,57 +65,1145 @@ struct ico_ivi_common {
                                             /* Function address of send configure to manager*/
 };
 
+/* Configuration cache(key)                     */
+struct ico_ivi_conf_key {
+    char    *name;                          /* key name                                 */
+    char    *value;                         /* value(trailing space removed)            */
+};
+
+/* Configuration cache(section)                 */
+struct ico_ivi_conf_section {
+    char    *name;                          /* section name                             */
+    int     nkey;                           /* number of keys                           */
+    struct ico_ivi_conf_key *key;           /* keys of this section                     */
+};
+
+/* Configuration reload callback                */
+struct ico_ivi_conf_reload {
+    struct wl_list  link;                   /* link                                     */
+    void    (*func)(void *data);            /* callback function                        */
+    void    *data;                          /* user data                                */
+};
+
+/* Configuration cache                          */
+struct ico_ivi_conf {
+    int     loaded;                         /* configuration file loaded                */
+    char    path[PATH_MAX];                 /* resolved path of configuration file      */
+    char    *image;                         /* file image(names and values point here)  */
+    int     nsection;                       /* number of sections                       */
+    struct ico_ivi_conf_section *section;   /* sections(file order)                     */
+    struct ico_ivi_conf_key *key;           /* keys of all sections(file order)         */
+};
+
+/* Metrics client(monitoring client)            */
+struct ico_ivi_metrics_client {
+    struct wl_list  link;                   /* link                                     */
+    struct wl_resource  *resource;          /* resource of ico_ivi_metrics              */
+    struct ico_ivi_timer timer;             /* periodic snapshot timer                  */
+    uint32_t    interval;                   /* periodic snapshot interval(ms, 0=none)   */
+    uint32_t    serial;                     /* serial number of snapshot                */
+    char        *prefix;                    /* name prefix of periodic snapshot         */
+};
+
+/* Timer wheel                                  */
+/*   level n slot covers 64^n ms, timers move to lower level at slot boundary   */
+#define TIMER_WHEEL_BITS    6               /* bits of slot index                       */
+#define TIMER_WHEEL_SLOTS   (1 << TIMER_WHEEL_BITS)
+                                            /* slots of each level                      */
+#define TIMER_WHEEL_LEVELS  4               /* levels(1ms, 64ms, 4s, 262s/slot)         */
+#define TIMER_WHEEL_NONE    (~((uint64_t)0))/* no timer in wheel                        */
+
+struct ico_ivi_timer_wheel {
+    int         fd;                         /* timerfd(-1=not opened)                   */
+    struct wl_event_source *source;         /* event source of timerfd                  */
+    uint64_t    now;                        /* next time(ms) to process                 */
+    uint64_t    armed;                      /* time(ms) set to timerfd(0=not set)       */
+    int         dispatching;                /* in expire callbacks                      */
+    uint64_t    bitmap[TIMER_WHEEL_LEVELS]; /* slots which have timers                  */
+    struct wl_list  slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+                                            /* timers of each slot                      */
+};
+
 /* This function is called from the ico_plugin-loader and initializes this module.*/
 int module_init(struct weston_compositor *ec);
 
+/* Load configuration file to cache             */
+static int conf_load(void);
+/* Find value of configuration key              */
+static const char *conf_find(const char *section, const char *key);
+/* Set value to configuration key table         */
+static int conf_set_key(const struct config_key *key, const char *value);
+/* Free configuration cache                     */
+static void conf_free(struct ico_ivi_conf *conf);
+/* Watch configuration file change              */
+static int conf_watch(struct weston_compositor *ec);
+/* Configuration file changed                   */
+static int conf_notify(int fd, uint32_t mask, void *data);
+/* Reload configuration and call callbacks      */
+static void conf_reload(void);
+/* Create binary trace ring buffer              */
+static int trace_open(const char *path, const int nrecord);
+/* Bind ico_ivi_metrics from monitoring client  */
+static void metrics_bind(struct wl_client *client, void *data,
+                         uint32_t version, uint32_t id);
+/* Unbind ico_ivi_metrics                       */
+static void metrics_unbind(struct wl_resource *resource);
+/* get request of ico_ivi_metrics               */
+static void metrics_get(struct wl_client *client, struct wl_resource *resource,
+                        const char *prefix);
+/* subscribe request of ico_ivi_metrics         */
+static void metrics_subscribe(struct wl_client *client, struct wl_resource *resource,
+                              const char *prefix, uint32_t interval);
+/* periodic snapshot timer                      */
+static void metrics_timer(void *data);
+/* send snapshot of metrics                     */
+static void metrics_send(struct ico_ivi_metrics_client *mclient, const char *prefix);
+/* current time of event loop watchdog(usec)    */
+static uint64_t watch_now(void);
+/* configure event loop watchdog                */
+static void watch_configure(void);
+/* periodic summary of event loop watchdog      */
+static void watch_summary(void *data);
+/* compare handlers by total time               */
+static int watch_compare(const void *a, const void *b);
+/* current time of timer wheel(ms)              */
+static uint64_t timer_now(void);
+/* open timerfd of timer wheel                  */
+static int timer_open(void);
+/* insert timer to wheel slot                   */
+static void timer_insert(struct ico_ivi_timer *timer);
+/* next time to process(expire or cascade)      */
+static uint64_t timer_next(void);
+/* process one time of timer wheel              */
+static void timer_process(const uint64_t time, struct wl_list *expired);
+/* set next time to timerfd                     */
+static void timer_program(void);
+/* timerfd expired                              */
+static int timer_dispatch(int fd, uint32_t mask, void *data);
+
+/* ico_ivi_metrics interface                    */
+static const struct ico_ivi_metrics_interface ico_ivi_metrics_implementation = {
+    metrics_get,
+    metrics_subscribe
+};
+
 /* Static area for control ico_ivi_common       */
 static struct ico_ivi_common *_ico_ivi_common = NULL;
 
 /* Special options                              */
 static int  _ico_option_flag = 0;
 
-/* Debug level                                  */
-static int  _ico_ivi_debug = 3;
+/* Debug level(referred by uifw_xxx macros inline)    */
+WL_EXPORT int   ico_ivi_debug_level = 3;
+
+/* Configuration cache                          */
+static struct ico_ivi_conf _ico_ivi_conf;
+
+/* Binary trace ring buffer(NULL=binary trace off)    */
+WL_EXPORT struct ico_trace_header *ico_ivi_trace_ring = NULL;
+static struct ico_trace_record  *_ico_ivi_trace_record = NULL;
+
+/* Configuration reload callbacks               */
+static struct wl_list _ico_ivi_conf_reload = { NULL, NULL };
+
+/* Registered metrics and monitoring clients    */
+static struct wl_list _ico_ivi_metric_list = { NULL, NULL };
+static struct wl_list _ico_ivi_metric_client = { NULL, NULL };
+static struct weston_compositor *_ico_ivi_ec = NULL;
+
+/* Event loop watchdog                          */
+WL_EXPORT int   ico_ivi_watch_enable = 0;
+static struct wl_list _ico_ivi_watch_list = { NULL, NULL };
+static int      _ico_ivi_watch_num = 0;     /* number of called handlers        */
+static uint32_t _ico_ivi_watch_threshold = 0;   /* stall threshold(usec, 0=none)*/
+static int      _ico_ivi_watch_interval = 0;    /* summary interval(sec, 0=none)*/
+static int      _ico_ivi_watch_top = 10;        /* number of handlers in summary*/
+static uint64_t _ico_ivi_watch_start = 0;       /* start time of summary interval*/
+static struct ico_ivi_timer _ico_ivi_watch_timer;  /* summary timer             */
+
+/* Timer wheel                                  */
+static struct ico_ivi_timer_wheel _ico_ivi_timer_wheel = { -1 };
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_special_option: Answer special option flag
+ *
+ * @param       None
+ * @return      Special option flag
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_option_flag(void)
+{
+    return _ico_option_flag;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_debuglevel: Answer debug output level.
+ *
+ * @param       None
+ * @return      Debug output level
+ * @retval      0       No debug output
+ * @retval      1       Only error output
+ * @retval      2       Error and information output
+ * @retval      3       All output with debug write
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_debuglevel(void)
+{
+    return ico_ivi_debug_level;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_trace_write: Write binary trace record to ring buffer.
+ *          Record is reserved by atomic increment of head, and sequence number
+ *          is written at last, so decoder can detect a record in writing.
+ *
+ * @param[in]   id          Tracepoint id(ICO_TP_xxx)
+ * @param[in]   nargs       Number of arguments(0 to ICO_TRACE_MAXARGS)
+ * @param[in]   ...         Arguments(int)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_trace_write(const int id, const int nargs, ...)
+{
+    struct ico_trace_header *ring = ico_ivi_trace_ring;
+    struct ico_trace_record *rec;
+    struct timespec ts;
+    uint32_t    seq;
+    va_list     ap;
+    int         i;
+
+    if (! ring) return;
+
+    seq = __sync_fetch_and_add(&ring->head, 1);
+    rec = &_ico_ivi_trace_record[seq & (ring->nrecord - 1)];
+    rec->seq = 0;
+    __sync_synchronize();
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    rec->time = ((uint64_t)ts.tv_sec) * 1000000 + (ts.tv_nsec / 1000);
+    rec->id = id;
+    rec->nargs = (nargs > ICO_TRACE_MAXARGS) ? ICO_TRACE_MAXARGS : nargs;
+    va_start(ap, nargs);
+    for (i = 0; i < rec->nargs; i++)    {
+        rec->arg[i] = va_arg(ap, int);
+    }
+    va_end(ap);
+
+    __sync_synchronize();
+    rec->seq = seq + 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   trace_open: Create binary trace ring buffer file and map it.
+ *          File is mapped as shared, so records remain in the file after fault.
+ *          Previous file(records until last fault) is renamed to <path>.old.
+ *
+ * @param[in]   path        Trace file path
+ * @param[in]   nrecord     Number of records(round up to 2^n)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_EIO     File create or map error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+trace_open(const char *path, const int nrecord)
+{
+    int     fd;
+    int     num;
+    size_t  size;
+    void    *map;
+    struct timespec ts;
+    struct ico_trace_header *ring;
+    char    oldpath[PATH_MAX];
+
+    for (num = 16; (num < nrecord) && (num < (1 << 24)); num <<= 1)    ;
+    size = sizeof(struct ico_trace_header) + sizeof(struct ico_trace_record) * num;
+
+    /* keep records of previous run for post-mortem */
+    if (snprintf(oldpath, sizeof(oldpath), "%s.old", path) >= (int)sizeof(oldpath))   {
+        uifw_warn("trace_open: %s name too long, previous trace not saved", path);
+    }
+    else if ((rename(path, oldpath) < 0) && (errno != ENOENT))  {
+        uifw_warn("trace_open: %s can not rename to %s[%d]", path, oldpath, errno);
+    }
+
+    fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        uifw_error("trace_open: %s can not create", path);
+        return ICO_IVI_EIO;
+    }
+    if (ftruncate(fd, size) < 0)    {
+        uifw_error("trace_open: %s can not extend to %d", path, (int)size);
+        close(fd);
+        return ICO_IVI_EIO;
+    }
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)  {
+        uifw_error("trace_open: %s can not map", path);
+        return ICO_IVI_EIO;
+    }
+    memset(map, 0, size);
+
+    ring = (struct ico_trace_header *)map;
+    ring->magic = ICO_TRACE_MAGIC;
+    ring->version = ICO_TRACE_VERSION;
+    ring->hdrsize = sizeof(struct ico_trace_header);
+    ring->recsize = sizeof(struct ico_trace_record);
+    ring->nrecord = num;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ring->basetime = ((uint64_t)ts.tv_sec) * 1000000 + (ts.tv_nsec / 1000);
+
+    _ico_ivi_trace_record = (struct ico_trace_record *)(ring + 1);
+    ico_ivi_trace_ring = ring;
+    uifw_info("trace_open: binary trace %s(%d records)", path, num);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_metric_regist: Regist runtime metric.
+ *          Metric is updated by ico_ivi_metric_add/set(counter/gauge) or
+ *          ico_ivi_metric_record(histogram) without lock, and monitoring
+ *          clients get it by ico_ivi_metrics interface.
+ *
+ * @param[in]   name        Metric name(ex. "window_mgr.surfaces")
+ * @param[in]   type        Metric type(ICO_IVI_METRIC_xxx)
+ * @return      Metric
+ * @retval      !=NULL      Success(if same name exists, registered metric)
+ * @retval      ==NULL      Out of memory(update macros ignore NULL)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   struct ico_ivi_metric *
+ico_ivi_metric_regist(const char *name, const int type)
+{
+    struct ico_ivi_metric   *metric;
+
+    if (_ico_ivi_metric_list.next == NULL)  {
+        wl_list_init(&_ico_ivi_metric_list);
+    }
+    wl_list_for_each (metric, &_ico_ivi_metric_list, link)  {
+        if (strcmp(metric->name, name) == 0)    {
+            return metric;
+        }
+    }
+
+    metric = (struct ico_ivi_metric *)malloc(sizeof(struct ico_ivi_metric));
+    if (! metric)   {
+        uifw_error("ico_ivi_metric_regist: %s No Memory", name);
+        return NULL;
+    }
+    memset(metric, 0, sizeof(struct ico_ivi_metric));
+    strncpy(metric->name, name, sizeof(metric->name) - 1);
+    metric->type = type;
+    wl_list_insert(_ico_ivi_metric_list.prev, &metric->link);
+    uifw_trace("ico_ivi_metric_regist: %s(type=%d)", metric->name, type);
+    return metric;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_metric_record: Add sample to histogram metric(lock-free)
+ *
+ * @param[in]   metric      Histogram metric(if NULL, ignored)
+ * @param[in]   sample      Sample value(ex. latency usec)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_metric_record(struct ico_ivi_metric *metric, const uint32_t sample)
+{
+    int         idx;
+    uint32_t    max;
+
+    if (! metric)   return;
+
+    idx = (sample == 0) ? 0 : (32 - __builtin_clz(sample));
+    if (idx >= ICO_IVI_METRIC_BUCKETS)  {
+        idx = ICO_IVI_METRIC_BUCKETS - 1;
+    }
+    __sync_fetch_and_add(&metric->bucket[idx], 1);
+    __sync_fetch_and_add(&metric->count, 1);
+    __sync_fetch_and_add(&metric->sum, (uint64_t)sample);
+    for (max = metric->max; sample > max; max = metric->max)    {
+        if (__sync_bool_compare_and_swap(&metric->max, max, sample))    break;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_bind: Bind ico_ivi_metrics from monitoring client
+ *
+ * @param[in]   client      Client
+ * @param[in]   data        User data(unused)
+ * @param[in]   version     Protocol version
+ * @param[in]   id          Client object id
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_bind(struct wl_client *client, void *data, uint32_t version, uint32_t id)
+{
+    struct ico_ivi_metrics_client   *mclient;
+
+    uifw_trace("metrics_bind: Enter(client=%08x)", (int)client);
+
+    mclient = (struct ico_ivi_metrics_client *)
+                  malloc(sizeof(struct ico_ivi_metrics_client));
+    if (! mclient)  {
+        uifw_error("metrics_bind: Leave(No Memory)");
+        return;
+    }
+    memset(mclient, 0, sizeof(struct ico_ivi_metrics_client));
+    ico_ivi_timer_init(&mclient->timer, metrics_timer, mclient);
+    mclient->resource = wl_client_add_object(client, &ico_ivi_metrics_interface,
+                                             &ico_ivi_metrics_implementation, id, mclient);
+    if (! mclient->resource)    {
+        free(mclient);
+        uifw_error("metrics_bind: Leave(No Memory)");
+        return;
+    }
+    mclient->resource->destroy = metrics_unbind;
+    wl_list_insert(&_ico_ivi_metric_client, &mclient->link);
+
+    uifw_trace("metrics_bind: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_unbind: Unbind ico_ivi_metrics
+ *
+ * @param[in]   resource    Resource of ico_ivi_metrics
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_unbind(struct wl_resource *resource)
+{
+    struct ico_ivi_metrics_client   *mclient = resource->data;
+
+    uifw_trace("metrics_unbind: Enter(resource=%08x)", (int)resource);
+
+    wl_list_remove(&mclient->link);
+    ico_ivi_timer_cancel(&mclient->timer);
+    free(mclient->prefix);
+    free(mclient);
+    free(resource);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_get: get request, send snapshot of metrics
+ *
+ * @param[in]   client      Client
+ * @param[in]   resource    Resource of ico_ivi_metrics
+ * @param[in]   prefix      Metric name prefix(NULL or empty is all metrics)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_get(struct wl_client *client, struct wl_resource *resource, const char *prefix)
+{
+    metrics_send((struct ico_ivi_metrics_client *)resource->data, prefix);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_subscribe: subscribe request, start or stop periodic snapshot
+ *
+ * @param[in]   client      Client
+ * @param[in]   resource    Resource of ico_ivi_metrics
+ * @param[in]   prefix      Metric name prefix(NULL or empty is all metrics)
+ * @param[in]   interval    Snapshot interval(ms, 0=stop)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_subscribe(struct wl_client *client, struct wl_resource *resource,
+                  const char *prefix, uint32_t interval)
+{
+    struct ico_ivi_metrics_client   *mclient = resource->data;
 
-static const struct config_key debug_config_keys[] = {
-        { "option_flag", CONFIG_KEY_INTEGER, &_ico_option_flag },
-        { "ivi_debug", CONFIG_KEY_INTEGER, &_ico_ivi_debug },
-    };
+    uifw_trace("metrics_subscribe: Enter(prefix=%s interval=%d)",
+               prefix ? prefix : "(NULL)", interval);
+
+    free(mclient->prefix);
+    mclient->prefix = ((prefix) && (*prefix)) ? strdup(prefix) : NULL;
+    mclient->interval = interval;
+
+    if (interval == 0)  {
+        ico_ivi_timer_cancel(&mclient->timer);
+    }
+    else if (ico_ivi_timer_arm(&mclient->timer, interval) != ICO_IVI_EOK)   {
+        uifw_error("metrics_subscribe: Leave(timer not armed)");
+        mclient->interval = 0;
+        return;
+    }
+    uifw_trace("metrics_subscribe: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_timer: periodic snapshot timer
+ *
+ * @param[in]   data        Monitoring client
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_timer(void *data)
+{
+    struct ico_ivi_metrics_client   *mclient = data;
+
+    if (mclient->interval > 0)  {
+        metrics_send(mclient, mclient->prefix);
+        ico_ivi_timer_arm(&mclient->timer, mclient->interval);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   metrics_send: send snapshot of metrics to monitoring client
+ *
+ * @param[in]   mclient     Monitoring client
+ * @param[in]   prefix      Metric name prefix(NULL or empty is all metrics)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+metrics_send(struct ico_ivi_metrics_client *mclient, const char *prefix)
+{
+    struct ico_ivi_metric   *metric;
+    struct wl_array         buckets;
+    struct wl_array         empty;
+    struct timespec         ts;
+    uint64_t                sum;
+    int     len = prefix ? strlen(prefix) : 0;
+
+    wl_array_init(&empty);
+    buckets.size = sizeof(uint32_t) * ICO_IVI_METRIC_BUCKETS;
+    buckets.alloc = 0;
+
+    if (_ico_ivi_metric_list.next != NULL)  {
+        wl_list_for_each (metric, &_ico_ivi_metric_list, link)  {
+            if ((len > 0) && (strncmp(metric->name, prefix, len) != 0)) continue;
+            buckets.data = (void *)metric->bucket;
+            /* read 64bits sum at once(also on 32bits CPU)  */
+            sum = __sync_fetch_and_add(&metric->sum, 0);
+            ico_ivi_metrics_send_metric(mclient->resource, metric->name, metric->type,
+                                        metric->value, metric->count, metric->max,
+                                        (uint32_t)(sum >> 32), (uint32_t)sum,
+                                        (metric->type == ICO_IVI_METRIC_HISTOGRAM) ?
+                                            &buckets : &empty);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    mclient->serial ++;
+    ico_ivi_metrics_send_done(mclient->resource, mclient->serial,
+                              (uint32_t)ts.tv_sec * 1000u + (uint32_t)(ts.tv_nsec / 1000000));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   watch_now: current time of event loop watchdog
+ *
+ * @param       None
+ * @return      CLOCK_MONOTONIC(usec, never 0)
+ */
+/*--------------------------------------------------------------------------*/
+static uint64_t
+watch_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec) * 1000000 + (ts.tv_nsec / 1000) + 1;
+}
 
-static const struct config_section conf_debug[] = {
-        { "debug", debug_config_keys, ARRAY_LENGTH(debug_config_keys) },
-    };
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_watch_enter: Start of handler dispatch(called by uifw_watch
+ *          only when watchdog is enabled). Handler is registered at first call.
+ *
+ * @param[in]   watch       Handler
+ * @return      Start time(usec)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   uint64_t
+ico_ivi_watch_enter(struct ico_ivi_watch *watch)
+{
+    if (watch->id == 0) {
+        if (_ico_ivi_watch_list.next == NULL)   {
+            wl_list_init(&_ico_ivi_watch_list);
+        }
+        watch->id = ++ _ico_ivi_watch_num;
+        wl_list_insert(_ico_ivi_watch_list.prev, &watch->link);
+        uifw_info("ico_ivi_watch: handler[%d] %s", watch->id, watch->name);
+    }
+    return watch_now();
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_watch_leave: End of handler dispatch(called at end of scope
+ *          of uifw_watch). Accumulate time, and log the stall over threshold.
+ *
+ * @param[in]   scope       Handler scope
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_watch_leave(struct ico_ivi_watch_scope *scope)
+{
+    struct ico_ivi_watch    *watch = scope->watch;
+    uint32_t    usec;
+
+    if (scope->start == 0)  return;
+
+    usec = (uint32_t)(watch_now() - scope->start);
+    watch->count ++;
+    watch->total += usec;
+    if (usec > watch->max)  {
+        watch->max = usec;
+    }
+    if ((_ico_ivi_watch_threshold > 0) && (usec >= _ico_ivi_watch_threshold))   {
+        watch->stall ++;
+        uifw_warn("ico_ivi_watch: %s stalled event loop %d.%03dms(%08x,%08x)",
+                  watch->name, usec / 1000, usec % 1000, scope->arg1, scope->arg2);
+        uifw_btrace(ICO_TP_WATCH_STALL, watch->id, usec, scope->arg1, scope->arg2);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_watch_release: Remove handlers in the plugin which will be
+ *          unloaded(handlers are static datas of each plugin).
+ *
+ * @param[in]   addr        Any address in the plugin
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_watch_release(const void *addr)
+{
+    struct ico_ivi_watch    *watch;
+    struct ico_ivi_watch    *next;
+    Dl_info     plugin;
+    Dl_info     info;
+
+    if ((_ico_ivi_watch_list.next == NULL) || (! dladdr(addr, &plugin)))   {
+        return;
+    }
+    wl_list_for_each_safe (watch, next, &_ico_ivi_watch_list, link) {
+        if ((dladdr(watch, &info)) && (info.dli_fbase == plugin.dli_fbase))    {
+            uifw_trace("ico_ivi_watch_release: handler[%d] %s", watch->id, watch->name);
+            wl_list_remove(&watch->link);
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_now: current time of timer wheel
+ *
+ * @param       None
+ * @return      current time(ms, monotonic clock)
+ */
+/*--------------------------------------------------------------------------*/
+static uint64_t
+timer_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000) + (uint64_t)(ts.tv_nsec / 1000000);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_open: open timerfd of timer wheel(at first arm)
+ *
+ * @param       None
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_EIO     timerfd error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+timer_open(void)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    int     level;
+    int     idx;
+
+    if (wheel->fd >= 0) {
+        return ICO_IVI_EOK;
+    }
+    if (! _ico_ivi_ec)  {
+        uifw_error("ico_ivi_timer: ico_ivi_common not initialized");
+        return ICO_IVI_EIO;
+    }
+    wheel->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (wheel->fd < 0)  {
+        uifw_error("ico_ivi_timer: timerfd_create error(%d)", errno);
+        return ICO_IVI_EIO;
+    }
+    wheel->source = wl_event_loop_add_fd(wl_display_get_event_loop(_ico_ivi_ec->wl_display),
+                                         wheel->fd, WL_EVENT_READABLE, timer_dispatch, NULL);
+    if (! wheel->source)    {
+        uifw_error("ico_ivi_timer: wl_event_loop_add_fd error");
+        close(wheel->fd);
+        wheel->fd = -1;
+        return ICO_IVI_EIO;
+    }
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++)    {
+        wheel->bitmap[level] = 0;
+        for (idx = 0; idx < TIMER_WHEEL_SLOTS; idx++)   {
+            wl_list_init(&wheel->slot[level][idx]);
+        }
+    }
+    wheel->now = timer_now();
+    wheel->armed = 0;
+    uifw_info("ico_ivi_timer: timer wheel opened(fd=%d)", wheel->fd);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_insert: insert timer to wheel slot.
+ *          Timer is inserted to the lowest level which covers its remaining
+ *          time, and moves to lower level at slot boundary(cascade).
+ *
+ * @param[in]   timer       Timer(not in wheel)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+timer_insert(struct ico_ivi_timer *timer)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    uint64_t    expire;
+    int         level;
+    int         idx;
+
+    if (timer->expire < wheel->now) {
+        /* already expired, expire at next process  */
+        timer->expire = wheel->now;
+    }
+    expire = timer->expire;
+    for (level = 0; level < (TIMER_WHEEL_LEVELS - 1); level++)  {
+        if ((expire - wheel->now) < (((uint64_t)1) << (TIMER_WHEEL_BITS * (level + 1))))  {
+            break;
+        }
+    }
+    if ((expire - wheel->now) >= (((uint64_t)1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))) {
+        /* over wheel range, insert to last slot and insert again at cascade    */
+        expire = wheel->now +
+                 (((uint64_t)1) << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    }
+    idx = (int)(expire >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+    timer->slot = (level * TIMER_WHEEL_SLOTS) + idx;
+    wl_list_insert(wheel->slot[level][idx].prev, &timer->link);
+    wheel->bitmap[level] |= ((uint64_t)1) << idx;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_next: next time to process, expire time of the nearest slot
+ *          of level 0 or boundary time of the nearest slot of upper levels.
+ *
+ * @param       None
+ * @return      next time(ms)
+ * @retval      TIMER_WHEEL_NONE    no timer in wheel
+ */
+/*--------------------------------------------------------------------------*/
+static uint64_t
+timer_next(void)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    uint64_t    next = TIMER_WHEEL_NONE;
+    uint64_t    base;
+    uint64_t    bitmap;
+    uint64_t    time;
+    int         shift;
+    int         pos;
+    int         level;
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS; level++)    {
+        if (wheel->bitmap[level] == 0)  continue;
+        shift = TIMER_WHEEL_BITS * level;
+        /* first slot boundary at or after now      */
+        base = (wheel->now + (((uint64_t)1) << shift) - 1) >> shift;
+        pos = (int)(base & (TIMER_WHEEL_SLOTS - 1));
+        bitmap = wheel->bitmap[level];
+        if (pos)    {
+            bitmap = (bitmap >> pos) | (bitmap << (TIMER_WHEEL_SLOTS - pos));
+        }
+        time = (base + __builtin_ctzll(bitmap)) << shift;
+        if (time < next)    {
+            next = time;
+        }
+    }
+    return next;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_process: process one time of timer wheel, cascade timers of
+ *          upper levels at slot boundary, and move expired timers to list.
+ *
+ * @param[in]   time        Time to process(ms, not less than wheel time)
+ * @param[out]  expired     Expired timers
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+timer_process(const uint64_t time, struct wl_list *expired)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    struct ico_ivi_timer    *timer;
+    struct wl_list  cascade;
+    int     level;
+    int     idx;
+
+    wheel->now = time;
+
+    /* cascade upper level slot at boundary     */
+    for (level = 1; level < TIMER_WHEEL_LEVELS; level++)    {
+        if (time & ((((uint64_t)1) << (TIMER_WHEEL_BITS * level)) - 1)) break;
+        idx = (int)(time >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1);
+        if ((wheel->bitmap[level] & (((uint64_t)1) << idx)) == 0)   continue;
+
+        wl_list_init(&cascade);
+        wl_list_insert_list(&cascade, &wheel->slot[level][idx]);
+        wl_list_init(&wheel->slot[level][idx]);
+        wheel->bitmap[level] &= ~(((uint64_t)1) << idx);
+        while (! wl_list_empty(&cascade))   {
+            timer = container_of(cascade.next, struct ico_ivi_timer, link);
+            wl_list_remove(&timer->link);
+            timer_insert(timer);
+        }
+    }
+
+    /* expire level 0 slot                      */
+    idx = (int)time & (TIMER_WHEEL_SLOTS - 1);
+    if (wheel->bitmap[0] & (((uint64_t)1) << idx))  {
+        wl_list_for_each (timer, &wheel->slot[0][idx], link)    {
+            timer->slot = -1;
+        }
+        wl_list_insert_list(expired->prev, &wheel->slot[0][idx]);
+        wl_list_init(&wheel->slot[0][idx]);
+        wheel->bitmap[0] &= ~(((uint64_t)1) << idx);
+    }
+    wheel->now = time + 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_program: set next time of timer wheel to timerfd
+ *
+ * @param       None
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+timer_program(void)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    struct itimerspec   its;
+    uint64_t    next;
+
+    next = timer_next();
+    if ((next == TIMER_WHEEL_NONE) && (wheel->armed == 0))  {
+        return;
+    }
+    if ((next != TIMER_WHEEL_NONE) && (next == wheel->armed))   {
+        return;
+    }
+    memset(&its, 0, sizeof(its));
+    if (next != TIMER_WHEEL_NONE)   {
+        its.it_value.tv_sec = (time_t)(next / 1000);
+        its.it_value.tv_nsec = (long)((next % 1000) * 1000000);
+        wheel->armed = next;
+    }
+    else    {
+        /* no timer, disarm                     */
+        wheel->armed = 0;
+    }
+    if (timerfd_settime(wheel->fd, TFD_TIMER_ABSTIME, &its, NULL) < 0)  {
+        uifw_error("ico_ivi_timer: timerfd_settime error(%d)", errno);
+        wheel->armed = 0;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   timer_dispatch: timerfd expired, process timer wheel until current
+ *          time and call callbacks of all expired timers in a batch.
+ *
+ * @param[in]   fd          timerfd
+ * @param[in]   mask        event mask(unused)
+ * @param[in]   data        user data(unused)
+ * @return      always 0
+ */
+/*--------------------------------------------------------------------------*/
+static int
+timer_dispatch(int fd, uint32_t mask, void *data)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    struct ico_ivi_timer    *timer;
+    struct wl_list  expired;
+    uint64_t    count;
+    uint64_t    now;
+    uint64_t    next;
+    int         num = 0;
+    uifw_watch("common.timer_wheel", 0, 0);
+
+    if (read(fd, &count, sizeof(count)) < 0)    {
+        /* spurious wakeup, process anyway      */
+        count = 0;
+    }
+    now = timer_now();
+    wl_list_init(&expired);
+    while (wheel->now <= now)   {
+        next = timer_next();
+        if (next > now) {
+            /* skip empty slots                 */
+            wheel->now = now + 1;
+            break;
+        }
+        timer_process(next, &expired);
+    }
+
+    /* call callbacks(timers may be armed or canceled in callbacks) */
+    wheel->dispatching = 1;
+    wheel->armed = 0;
+    while (! wl_list_empty(&expired))   {
+        timer = container_of(expired.next, struct ico_ivi_timer, link);
+        wl_list_remove(&timer->link);
+        wl_list_init(&timer->link);
+        num ++;
+        (*timer->func)(timer->data);
+    }
+    wheel->dispatching = 0;
+    timer_program();
+    uifw_trace("timer_dispatch: %d timers expired", num);
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_timer_init: Initialize timer(before first arm).
+ *          Timer is owned by caller, no memory is allocated.
+ *
+ * @param[in]   timer       Timer
+ * @param[in]   func        Expire callback
+ * @param[in]   data        User data(callback parameter)
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_timer_init(struct ico_ivi_timer *timer, void (*func)(void *data), void *data)
+{
+    memset(timer, 0, sizeof(struct ico_ivi_timer));
+    wl_list_init(&timer->link);
+    timer->slot = -1;
+    timer->func = func;
+    timer->data = data;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_timer_arm: Arm timer. Armed timer is re-armed.
+ *          Callback is called once after msec(resolution 1ms).
+ *
+ * @param[in]   timer       Timer(initialized by ico_ivi_timer_init)
+ * @param[in]   msec        Time until expire(ms)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_EIO     timerfd error
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_timer_arm(struct ico_ivi_timer *timer, const uint32_t msec)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    uint64_t    now;
+    int         level;
+
+    if (timer_open() != ICO_IVI_EOK)    {
+        return ICO_IVI_EIO;
+    }
+    ico_ivi_timer_cancel(timer);
+
+    now = timer_now();
+    if (! wheel->dispatching)   {
+        for (level = 0; level < TIMER_WHEEL_LEVELS; level++)    {
+            if (wheel->bitmap[level])   break;
+        }
+        if (level >= TIMER_WHEEL_LEVELS)    {
+            /* wheel is empty, advance wheel time   */
+            wheel->now = now;
+        }
+    }
+    timer->expire = now + msec;
+    timer_insert(timer);
+
+    if ((! wheel->dispatching) && ((wheel->armed == 0) || (timer->expire < wheel->armed)))  {
+        timer_program();
+    }
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_timer_cancel: Cancel timer. Not armed timer is ignored.
+ *
+ * @param[in]   timer       Timer
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   void
+ico_ivi_timer_cancel(struct ico_ivi_timer *timer)
+{
+    struct ico_ivi_timer_wheel  *wheel = &_ico_ivi_timer_wheel;
+    int     level;
+    int     idx;
+
+    if (! ico_ivi_timer_is_armed(timer))    {
+        return;
+    }
+    wl_list_remove(&timer->link);
+    wl_list_init(&timer->link);
+    if (timer->slot >= 0)   {
+        level = timer->slot / TIMER_WHEEL_SLOTS;
+        idx = timer->slot % TIMER_WHEEL_SLOTS;
+        if (wl_list_empty(&wheel->slot[level][idx]))    {
+            wheel->bitmap[level] &= ~(((uint64_t)1) << idx);
+        }
+        timer->slot = -1;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   watch_configure: configure event loop watchdog from [debug] section
+ *          (watch_threshold=stall threshold(ms), watch_summary=summary
+ *          interval(sec), watch_top=number of handlers in summary)
+ *
+ * @param       None
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+watch_configure(void)
+{
+    _ico_ivi_watch_threshold = ico_ivi_conf_integer("debug", "watch_threshold", 0) * 1000;
+    _ico_ivi_watch_interval = ico_ivi_conf_integer("debug", "watch_summary", 0);
+    _ico_ivi_watch_top = ico_ivi_conf_integer("debug", "watch_top", 10);
+    if (_ico_ivi_watch_top <= 0)    {
+        _ico_ivi_watch_top = 10;
+    }
+    ico_ivi_watch_enable = ((_ico_ivi_watch_threshold > 0) ||
+                            (_ico_ivi_watch_interval > 0)) ? 1 : 0;
+
+    if (_ico_ivi_watch_interval <= 0)   {
+        ico_ivi_timer_cancel(&_ico_ivi_watch_timer);
+    }
+    else if (ico_ivi_timer_arm(&_ico_ivi_watch_timer, _ico_ivi_watch_interval * 1000)
+                 != ICO_IVI_EOK)    {
+        uifw_warn("ico_ivi_watch: summary timer not armed");
+    }
+    _ico_ivi_watch_start = watch_now();
+
+    uifw_info("ico_ivi_watch: %s(threshold=%dms summary=%dsec top=%d)",
+              ico_ivi_watch_enable ? "enable" : "disable",
+              _ico_ivi_watch_threshold / 1000, _ico_ivi_watch_interval,
+              _ico_ivi_watch_top);
+}
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_special_option: Answer special option flag
+ * @brief   watch_compare: compare handlers by total time(for qsort, descending)
  *
- * @param       None
- * @return      Special option flag
+ * @param[in]   a           Handler
+ * @param[in]   b           Handler
+ * @return      compare result
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT   int
-ico_option_flag(void)
+static int
+watch_compare(const void *a, const void *b)
 {
-    return _ico_option_flag;
+    const struct ico_ivi_watch  *wa = *(struct ico_ivi_watch * const *)a;
+    const struct ico_ivi_watch  *wb = *(struct ico_ivi_watch * const *)b;
+
+    if (wa->total == wb->total) return 0;
+    return (wa->total < wb->total) ? 1 : -1;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_ivi_debuglevel: Answer debug output level.
+ * @brief   watch_summary: periodic summary of event loop watchdog.
+ *          Log top handlers by total dispatch time in this interval,
+ *          and clear the interval statistics.
  *
- * @param       None
- * @return      Debug output level
- * @retval      0       No debug output
- * @retval      1       Only error output
- * @retval      2       Error and information output
- * @retval      3       All output with debug write
+ * @param[in]   data        User data(unused)
+ * @return      None
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT   int
-ico_ivi_debuglevel(void)
+static void
+watch_summary(void *data)
 {
-    return _ico_ivi_debug;
+    struct ico_ivi_watch    *watch;
+    struct ico_ivi_watch    **sorted;
+    uint64_t    now = watch_now();
+    uint64_t    total = 0;
+    int         num = 0;
+    int         i;
+
+    if (_ico_ivi_watch_interval <= 0)   return;
+    ico_ivi_timer_arm(&_ico_ivi_watch_timer, _ico_ivi_watch_interval * 1000);
+
+    if ((_ico_ivi_watch_num <= 0) || (_ico_ivi_watch_list.next == NULL))    return;
+    sorted = (struct ico_ivi_watch **)malloc(sizeof(struct ico_ivi_watch *) *
+                                             _ico_ivi_watch_num);
+    if (! sorted)   {
+        uifw_error("ico_ivi_watch: summary No Memory");
+        return;
+    }
+    wl_list_for_each (watch, &_ico_ivi_watch_list, link)    {
+        if (watch->count > 0)   {
+            sorted[num++] = watch;
+            total += watch->total;
+        }
+    }
+    qsort(sorted, num, sizeof(struct ico_ivi_watch *), watch_compare);
+
+    uifw_info("ico_ivi_watch: summary %d handlers %d.%03dms in %dms",
+              num, (int)(total / 1000), (int)(total % 1000),
+              (int)((now - _ico_ivi_watch_start) / 1000));
+    for (i = 0; (i < num) && (i < _ico_ivi_watch_top); i++) {
+        watch = sorted[i];
+        uifw_info("ico_ivi_watch: %2d %-32s total=%d.%03dms count=%u avg=%uus "
+                  "max=%uus stall=%u", i + 1, watch->name,
+                  (int)(watch->total / 1000), (int)(watch->total % 1000), watch->count,
+                  (uint32_t)(watch->total / watch->count), watch->max, watch->stall);
+    }
+    wl_list_for_each (watch, &_ico_ivi_watch_list, link)    {
+        watch->count = 0;
+        watch->stall = 0;
+        watch->max = 0;
+        watch->total = 0;
+    }
+    free(sorted);
+    _ico_ivi_watch_start = now;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -294,6 +1394,621 @@ ico_ivi_dispname_2_node(const char *dispname)
     return 0;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_conf_integer: Get integer value from configuration
+ *
+ * @param[in]   section     Section name
+ * @param[in]   key         Key name
+ * @param[in]   defvalue    Default value(if key dose not exist or not integer)
+ * @return      Value of key
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_conf_integer(const char *section, const char *key, const int defvalue)
+{
+    const char  *value;
+    char        *end;
+    int         i;
+
+    value = conf_find(section, key);
+    if ((! value) || (*value == 0)) {
+        return defvalue;
+    }
+    i = strtol(value, &end, 0);
+    if (*end != 0)  {
+        uifw_warn("ico_ivi_conf_integer: [%s]%s=%s is not integer", section, key, value);
+        return defvalue;
+    }
+    return i;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_conf_string: Get string value from configuration
+ *
+ * @param[in]   section     Section name
+ * @param[in]   key         Key name
+ * @param[in]   defvalue    Default value(if key dose not exist)
+ * @return      Value of key(in the configuration cache, caller must not free,
+ *              and it is valid until configuration reload)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   const char *
+ico_ivi_conf_string(const char *section, const char *key, const char *defvalue)
+{
+    const char  *value;
+
+    value = conf_find(section, key);
+    return value ? value : defvalue;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_conf_parse: Set configuration to key tables from cache,
+ *          same interface as parse_config_file without file access.
+ *          done function of section is called at end of each section,
+ *          so repeated sections are available.
+ *
+ * @param[in]   sections        Section tables
+ * @param[in]   num_sections    Number of section tables
+ * @param[in]   data            User data(done function parameter)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOENT  Configuration file dose not exist
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_conf_parse(const struct config_section *sections, const int num_sections,
+                   void *data)
+{
+    int     i, j, k, l;
+    struct ico_ivi_conf_section *cs;
+
+    if ((! _ico_ivi_conf.loaded) && (conf_load() != ICO_IVI_EOK))  {
+        return ICO_IVI_ENOENT;
+    }
+
+    for (i = 0; i < _ico_ivi_conf.nsection; i++)    {
+        cs = &_ico_ivi_conf.section[i];
+        for (j = 0; j < num_sections; j++)  {
+            if (strcmp(sections[j].name, cs->name) == 0)    break;
+        }
+        if (j >= num_sections)  continue;
+
+        for (k = 0; k < cs->nkey; k++)  {
+            for (l = 0; l < sections[j].num_keys; l++)  {
+                if (strcmp(sections[j].keys[l].name, cs->key[k].name) == 0)  {
+                    conf_set_key(&sections[j].keys[l], cs->key[k].value);
+                    break;
+                }
+            }
+        }
+        if (sections[j].done)   {
+            sections[j].done(data);
+        }
+    }
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_conf_add_reload: Regist callback of configuration reload.
+ *          When configuration file changed, callbacks are called in regist order
+ *          after cache reloaded, so plugins can apply new values at runtime.
+ *
+ * @param[in]   func        Callback function
+ * @param[in]   data        User data(callback parameter)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOMEM  Out of memory
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_conf_add_reload(void (*func)(void *data), void *data)
+{
+    struct ico_ivi_conf_reload  *reload;
+
+    reload = (struct ico_ivi_conf_reload *)malloc(sizeof(struct ico_ivi_conf_reload));
+    if (! reload)   {
+        uifw_error("ico_ivi_conf_add_reload: No Memory");
+        return ICO_IVI_ENOMEM;
+    }
+    memset(reload, 0, sizeof(struct ico_ivi_conf_reload));
+    reload->func = func;
+    reload->data = data;
+    if (_ico_ivi_conf_reload.next == NULL)  {
+        wl_list_init(&_ico_ivi_conf_reload);
+    }
+    wl_list_insert(_ico_ivi_conf_reload.prev, &reload->link);
+    uifw_trace("ico_ivi_conf_add_reload: Regist %08x(%08x)", (int)func, (int)data);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_conf_remove_reload: Remove callback of configuration reload.
+ *          (plugin must remove its callbacks before unload)
+ *
+ * @param[in]   func        Callback function
+ * @param[in]   data        User data(callback parameter)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOENT  Callback not registered
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_conf_remove_reload(void (*func)(void *data), void *data)
+{
+    struct ico_ivi_conf_reload  *reload;
+
+    if (_ico_ivi_conf_reload.next != NULL)  {
+        wl_list_for_each (reload, &_ico_ivi_conf_reload, link) {
+            if ((reload->func == func) && (reload->data == data))   {
+                wl_list_remove(&reload->link);
+                free(reload);
+                uifw_trace("ico_ivi_conf_remove_reload: Remove %08x(%08x)",
+                           (int)func, (int)data);
+                return ICO_IVI_EOK;
+            }
+        }
+    }
+    return ICO_IVI_ENOENT;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_hook_add: Add hook function to hook chain.
+ *          Hook functions are called in priority order, and functions of
+ *          same priority are called in regist order.
+ *          Hook function added in iteration of same chain is called in this
+ *          iteration only if it is placed after current hook.
+ *
+ * @param[in]   chain       Hook chain
+ * @param[in]   priority    Priority(ICO_IVI_HOOK_PRIORITY_xxx, smaller is first)
+ * @param[in]   func        Hook function
+ * @param[in]   data        User data(last argument of hook function)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_EBUSY   Same function and user data already registered
+ * @retval      ICO_IVI_ENOMEM  Out of memory
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_hook_add(struct ico_ivi_hook_chain *chain, const int priority,
+                 void (*func)(void), void *data)
+{
+    struct ico_ivi_hook *hook;
+    int     idx;
+    int     i;
+
+    for (i = 0; i < chain->num; i++)    {
+        if ((chain->hook[i].func == func) && (chain->hook[i].data == data)) {
+            uifw_warn("ico_ivi_hook_add: %08x(%08x) already registered",
+                      (int)func, (int)data);
+            return ICO_IVI_EBUSY;
+        }
+    }
+    if (chain->num >= chain->max)   {
+        hook = (struct ico_ivi_hook *)realloc(chain->hook,
+                                    sizeof(struct ico_ivi_hook) * (chain->max + 4));
+        if (! hook) {
+            uifw_error("ico_ivi_hook_add: No Memory");
+            return ICO_IVI_ENOMEM;
+        }
+        chain->hook = hook;
+        chain->max += 4;
+    }
+
+    /* insert after hook functions of same or higher priority   */
+    for (idx = chain->num; idx > 0; idx--)  {
+        if (chain->hook[idx - 1].priority <= priority)  break;
+        chain->hook[idx] = chain->hook[idx - 1];
+    }
+    chain->hook[idx].priority = priority;
+    chain->hook[idx].func = func;
+    chain->hook[idx].data = data;
+    chain->num ++;
+    if (idx < chain->next)  {
+        /* added before current hook in iteration, skip it in this iteration */
+        chain->next ++;
+    }
+    uifw_trace("ico_ivi_hook_add: Hook %08x(%08x) priority=%d[%d/%d]",
+               (int)func, (int)data, priority, idx, chain->num);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_ivi_hook_remove: Remove hook function from hook chain
+ *
+ * @param[in]   chain       Hook chain
+ * @param[in]   func        Hook function
+ * @param[in]   data        User data(same as ico_ivi_hook_add)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOENT  Hook function dose not exist
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT   int
+ico_ivi_hook_remove(struct ico_ivi_hook_chain *chain, void (*func)(void), void *data)
+{
+    int     i;
+
+    for (i = 0; i < chain->num; i++)    {
+        if ((chain->hook[i].func == func) && (chain->hook[i].data == data)) {
+            chain->num --;
+            memmove(&chain->hook[i], &chain->hook[i + 1],
+                    sizeof(struct ico_ivi_hook) * (chain->num - i));
+            if (i < chain->next)    {
+                /* removed current or called hook in iteration, not skip next   */
+                chain->next --;
+            }
+            uifw_trace("ico_ivi_hook_remove: Unhook %08x(%08x)", (int)func, (int)data);
+            return ICO_IVI_EOK;
+        }
+    }
+    uifw_warn("ico_ivi_hook_remove: %08x(%08x) dose not exist", (int)func, (int)data);
+    return ICO_IVI_ENOENT;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_load: Load configuration file to cache.
+ *          File is read at once, and sections and keys are indexed.
+ *
+ * @param       None
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOENT  Configuration file dose not exist
+ * @retval      ICO_IVI_ENOMEM  Out of memory
+ */
+/*--------------------------------------------------------------------------*/
+static int
+conf_load(void)
+{
+    int     config_fd;
+    struct stat st;
+    char    fdpath[64];
+    int     size;
+    int     len;
+    int     nline;
+    int     nkey;
+    char    *p;
+    char    *next;
+    char    *eq;
+    char    *end;
+    struct ico_ivi_conf_section *cs = NULL;
+
+    _ico_ivi_conf.loaded = 1;
+
+    config_fd = open_config_file(ICO_IVI_PLUGIN_CONFIG);
+    if (config_fd < 0)  {
+        return ICO_IVI_ENOENT;
+    }
+    /* resolve path of configuration file for change watch  */
+    snprintf(fdpath, sizeof(fdpath), "/proc/self/fd/%d", config_fd);
+    len = readlink(fdpath, _ico_ivi_conf.path, sizeof(_ico_ivi_conf.path) - 1);
+    _ico_ivi_conf.path[(len > 0) ? len : 0] = 0;
+
+    if ((fstat(config_fd, &st) < 0) || (st.st_size <= 0))   {
+        close(config_fd);
+        return ICO_IVI_ENOENT;
+    }
+    size = (int)st.st_size;
+    _ico_ivi_conf.image = malloc(size + 1);
+    if (! _ico_ivi_conf.image)  {
+        close(config_fd);
+        uifw_error("conf_load: No Memory");
+        return ICO_IVI_ENOMEM;
+    }
+    for (len = 0; len < size; len += nline) {
+        nline = read(config_fd, _ico_ivi_conf.image + len, size - len);
+        if (nline <= 0) break;
+    }
+    close(config_fd);
+    _ico_ivi_conf.image[len] = 0;
+
+    /* count lines for index size   */
+    nline = 1;
+    for (p = _ico_ivi_conf.image; *p; p++)  {
+        if (*p == '\n')    nline ++;
+    }
+    _ico_ivi_conf.section = malloc(sizeof(struct ico_ivi_conf_section) * nline);
+    _ico_ivi_conf.key = malloc(sizeof(struct ico_ivi_conf_key) * nline);
+    if ((! _ico_ivi_conf.section) || (! _ico_ivi_conf.key)) {
+        uifw_error("conf_load: No Memory");
+        conf_free(&_ico_ivi_conf);
+        _ico_ivi_conf.loaded = 1;
+        return ICO_IVI_ENOMEM;
+    }
+
+    /* make index of sections and keys  */
+    nkey = 0;
+    for (p = _ico_ivi_conf.image; *p; p = next) {
+        next = strchrnul(p, '\n');
+        if (*next)  {
+            *next++ = 0;
+        }
+        /* remove trailing space        */
+        end = p + strlen(p);
+        while ((end > p) && (isspace(*(end - 1))))  end--;
+        *end = 0;
+
+        if ((*p == '#') || (*p == 0))   {
+            continue;
+        }
+        if (*p == '[')  {
+            end = strchr(p + 1, ']');
+            if ((! end) || (end[1] != 0))   {
+                uifw_warn("conf_load: malformed section header: %s", p);
+                cs = NULL;
+                continue;
+            }
+            *end = 0;
+            cs = &_ico_ivi_conf.section[_ico_ivi_conf.nsection++];
+            cs->name = p + 1;
+            cs->nkey = 0;
+            cs->key = &_ico_ivi_conf.key[nkey];
+        }
+        else if ((eq = strchr(p, '=')) != NULL) {
+            if (! cs)   continue;
+            *eq = 0;
+            cs->key[cs->nkey].name = p;
+            cs->key[cs->nkey].value = eq + 1;
+            cs->nkey ++;
+            nkey ++;
+        }
+        else    {
+            uifw_warn("conf_load: malformed config line: %s", p);
+        }
+    }
+    uifw_trace("conf_load: %d sections, %d keys", _ico_ivi_conf.nsection, nkey);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_free: Free configuration cache(path is kept)
+ *
+ * @param[in]   conf        Configuration cache
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+conf_free(struct ico_ivi_conf *conf)
+{
+    free(conf->section);
+    free(conf->key);
+    free(conf->image);
+    conf->loaded = 0;
+    conf->image = NULL;
+    conf->nsection = 0;
+    conf->section = NULL;
+    conf->key = NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_watch: Watch change of configuration file.
+ *          Directory of configuration file is watched, because editors
+ *          replace the file by rename.
+ *
+ * @param[in]   ec          Weston compositor
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_ENOENT  Configuration file dose not exist
+ * @retval      ICO_IVI_EIO     inotify error
+ */
+/*--------------------------------------------------------------------------*/
+static int
+conf_watch(struct weston_compositor *ec)
+{
+    int     fd;
+    char    dir[PATH_MAX];
+    char    *p;
+
+    if (_ico_ivi_conf.path[0] != '/')   {
+        return ICO_IVI_ENOENT;
+    }
+    strncpy(dir, _ico_ivi_conf.path, sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = 0;
+    p = strrchr(dir, '/');
+    if (p == dir)   {
+        p[1] = 0;
+    }
+    else    {
+        *p = 0;
+    }
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return ICO_IVI_EIO;
+    }
+    if (inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)  {
+        close(fd);
+        return ICO_IVI_EIO;
+    }
+    if (! wl_event_loop_add_fd(wl_display_get_event_loop(ec->wl_display), fd,
+                               WL_EVENT_READABLE, conf_notify, NULL))   {
+        close(fd);
+        return ICO_IVI_EIO;
+    }
+    uifw_info("conf_watch: watch %s", _ico_ivi_conf.path);
+    return ICO_IVI_EOK;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_notify: Configuration file changed(inotify event)
+ *
+ * @param[in]   fd          inotify file descriptor
+ * @param[in]   mask        event mask(unused)
+ * @param[in]   data        user data(unused)
+ * @return      always 0
+ */
+/*--------------------------------------------------------------------------*/
+static int
+conf_notify(int fd, uint32_t mask, void *data)
+{
+    char    buf[sizeof(struct inotify_event) + NAME_MAX + 1]
+                __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    struct inotify_event    *event;
+    const char  *name;
+    int     len;
+    int     i;
+    int     changed = 0;
+
+    name = strrchr(_ico_ivi_conf.path, '/') + 1;
+
+    while ((len = read(fd, buf, sizeof(buf))) > 0)  {
+        for (i = 0; i < len; i += sizeof(struct inotify_event) + event->len)  {
+            event = (struct inotify_event *)&buf[i];
+            if ((event->len > 0) && (strcmp(event->name, name) == 0))   {
+                changed = 1;
+            }
+        }
+    }
+    if (changed)    {
+        conf_reload();
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_reload: Reload configuration file and call reload callbacks.
+ *          If new configuration can not load, current configuration is kept.
+ *
+ * @param       None
+ * @return      None
+ */
+/*--------------------------------------------------------------------------*/
+static void
+conf_reload(void)
+{
+    struct ico_ivi_conf         old;
+    struct ico_ivi_conf_reload  *reload;
+
+    uifw_info("conf_reload: Enter(%s)", _ico_ivi_conf.path);
+
+    memcpy(&old, &_ico_ivi_conf, sizeof(old));
+    memset(&_ico_ivi_conf, 0, sizeof(_ico_ivi_conf));
+    if ((conf_load() != ICO_IVI_EOK) || (_ico_ivi_conf.nsection <= 0))  {
+        uifw_warn("conf_reload: Leave(%s not loaded, keep current)", old.path);
+        conf_free(&_ico_ivi_conf);
+        memcpy(&_ico_ivi_conf, &old, sizeof(old));
+        return;
+    }
+    conf_free(&old);
+
+    _ico_option_flag = ico_ivi_conf_integer("debug", "option_flag", 0);
+    ico_ivi_debug_level = ico_ivi_conf_integer("debug", "ivi_debug", 3);
+    watch_configure();
+
+    if (_ico_ivi_conf_reload.next != NULL)  {
+        wl_list_for_each (reload, &_ico_ivi_conf_reload, link) {
+            (*reload->func)(reload->data);
+        }
+    }
+    uifw_info("conf_reload: Leave(option flag=0x%08x debug=%d)",
+              _ico_option_flag, ico_ivi_debug_level);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_find: Find value of configuration key
+ *          (if same section exists, first section)
+ *
+ * @param[in]   section     Section name
+ * @param[in]   key         Key name
+ * @return      Value
+ * @retval      !=NULL      Value of key
+ * @retval      ==NULL      Key dose not exist
+ */
+/*--------------------------------------------------------------------------*/
+static const char *
+conf_find(const char *section, const char *key)
+{
+    int     i, j;
+    struct ico_ivi_conf_section *cs;
+
+    if (! _ico_ivi_conf.loaded) {
+        conf_load();
+    }
+    for (i = 0; i < _ico_ivi_conf.nsection; i++)    {
+        cs = &_ico_ivi_conf.section[i];
+        if (strcmp(cs->name, section) != 0) continue;
+        for (j = 0; j < cs->nkey; j++)  {
+            if (strcmp(cs->key[j].name, key) == 0)  {
+                return cs->key[j].value;
+            }
+        }
+        break;
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   conf_set_key: Set value to configuration key table
+ *
+ * @param[in]   key         Configuration key table
+ * @param[in]   value       Value(trailing space removed)
+ * @return      result
+ * @retval      ICO_IVI_EOK     Success
+ * @retval      ICO_IVI_EINVAL  Invalid value
+ * @retval      ICO_IVI_ENOMEM  Out of memory
+ */
+/*--------------------------------------------------------------------------*/
+static int
+conf_set_key(const struct config_key *key, const char *value)
+{
+    char    *end;
+    char    *s;
+    int     i;
+    unsigned int ui;
+
+    switch (key->type)  {
+    case CONFIG_KEY_INTEGER:
+        i = strtol(value, &end, 0);
+        if ((*value == 0) || (*end != 0))   break;
+        *(int *)key->data = i;
+        return ICO_IVI_EOK;
+
+    case CONFIG_KEY_UNSIGNED_INTEGER:
+        ui = strtoul(value, &end, 0);
+        if ((*value == 0) || (*end != 0))   break;
+        *(unsigned int *)key->data = ui;
+        return ICO_IVI_EOK;
+
+    case CONFIG_KEY_STRING:
+        s = strdup(value);
+        if (! s)    {
+            return ICO_IVI_ENOMEM;
+        }
+        *(char **)key->data = s;
+        return ICO_IVI_EOK;
+
+    case CONFIG_KEY_BOOLEAN:
+        if (strcmp(value, "false") == 0)    {
+            *(int *)key->data = 0;
+        }
+        else if (strcmp(value, "true") == 0)    {
+            *(int *)key->data = 1;
+        }
+        else    {
+            break;
+        }
+        return ICO_IVI_EOK;
+
+    default:
+        break;
+    }
+    uifw_warn("conf_set_key: %s=%s invalid value", key->name, value);
+    return ICO_IVI_EINVAL;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   IVI Common: Initialize function of ico_ivi_common.
@@ -307,18 +2022,52 @@ ico_ivi_dispname_2_node(const char *dispname)
 WL_EXPORT int
 module_init(struct weston_compositor *ec)
 {
-    int     config_fd;
+    const char  *trace_file;
 
     uifw_info("ico_ivi_common: Enter(module_init)");
 
-    /* Get debug level from config file         */
-    config_fd = open_config_file(ICO_IVI_PLUGIN_CONFIG);
-    parse_config_file(config_fd, conf_debug, ARRAY_LENGTH(conf_debug), NULL);
-    close(config_fd);
-    
+    /* Load config file to cache, all plugins use this cache    */
+    if (! _ico_ivi_conf.loaded) {
+        if (conf_load() != ICO_IVI_EOK) {
+            uifw_warn("ico_ivi_common: %s not loaded", ICO_IVI_PLUGIN_CONFIG);
+        }
+    }
+
+    /* Get debug level from config              */
+    _ico_option_flag = ico_ivi_conf_integer("debug", "option_flag", _ico_option_flag);
+    ico_ivi_debug_level = ico_ivi_conf_integer("debug", "ivi_debug", ico_ivi_debug_level);
+
     uifw_info("ico_ivi_common: option flag=0x%08x debug=%d",
               ico_option_flag(), ico_ivi_debuglevel());
 
+    /* Start binary trace                       */
+    trace_file = ico_ivi_conf_string("debug", "trace_file", NULL);
+    if ((trace_file) && (*trace_file))  {
+        trace_open(trace_file, ico_ivi_conf_integer("debug", "trace_records",
+                                                    ICO_TRACE_RECORDS));
+    }
+
+    /* Start event loop watchdog                */
+    _ico_ivi_ec = ec;
+    ico_ivi_timer_init(&_ico_ivi_watch_timer, watch_summary, NULL);
+    watch_configure();
+
+    /* Interface to monitoring client of runtime metrics   */
+    if (_ico_ivi_metric_list.next == NULL)  {
+        wl_list_init(&_ico_ivi_metric_list);
+    }
+    wl_list_init(&_ico_ivi_metric_client);
+    if (wl_display_add_global(ec->wl_display, &ico_ivi_metrics_interface,
+                              NULL, metrics_bind) == NULL)  {
+        uifw_error("ico_ivi_common: Leave(wl_display_add_global metrics failed)");
+        return -1;
+    }
+
+    /* Watch change of config file for live reload  */
+    if (conf_watch(ec) != ICO_IVI_EOK)  {
+        uifw_warn("ico_ivi_common: %s change not watched", ICO_IVI_PLUGIN_CONFIG);
+    }
+
     /* Allocate static area                     */
     _ico_ivi_common = (struct ico_ivi_common *) malloc(sizeof(struct ico_ivi_common));
     if (! _ico_ivi_common)  {
@@ -30,6 +30,8 @@
 #ifndef _ICO_IVI_COMMON_H_
 #define _ICO_IVI_COMMON_H_
 
+#include "ico_ivi_trace.h"
+
 /* Macros                               */
 #define ICO_IVI_NODEID_2_HOSTID( nodeid )       (((unsigned int)nodeid) >> 16)
 #define ICO_IVI_NODEID_2_DISPLAYNO( nodeid )    (((unsigned int)nodeid) & 0x0ffff)
@@ -55,6 +57,18 @@
 /* Configuration file                   */
 #define ICO_IVI_PLUGIN_CONFIG   "weston_ivi_plugin.ini"
 
+/* Plugin dependency declaration(read by ico_plugin_loader before dlopen)   */
+/*   list is comma separated file names of plugins, ex. "ico_ivi_common.so" */
+#define ICO_PLUGIN_DEPENDS_SECTION  ".ico_plugin_depends"
+#define ICO_PLUGIN_DEPENDS(list)    \
+    static const char _ico_plugin_depends[]     \
+        __attribute__((section(ICO_PLUGIN_DEPENDS_SECTION), used)) = list
+
+/* Reloadable plugin exports module_exit, ico_plugin_loader unloads and reloads it  */
+/* when its file is replaced. module_exit must release all references to the plugin */
+/* (registered tables, hooks, callbacks and timers) and return 0 to allow unload.   */
+#define ICO_PLUGIN_EXIT_ENTRY   "module_exit"
+
 /* System limit                         */
 #define ICO_IVI_APPID_LENGTH    (128)       /* Maximum length of applicationId(AppCore) */
                                             /* (with terminate NULL)                */
@@ -99,25 +113,191 @@ int ico_ivi_send_surface_change(struct weston_surface *surface,
 int ico_option_flag(void);
 int ico_ivi_debuglevel(void);
 
+                                        /* Get integer value from configuration     */
+int ico_ivi_conf_integer(const char *section, const char *key, const int defvalue);
+                                        /* Get string value from configuration      */
+const char *ico_ivi_conf_string(const char *section, const char *key,
+                                const char *defvalue);
+                                        /* Set configuration to key tables          */
+int ico_ivi_conf_parse(const struct config_section *sections, const int num_sections,
+                       void *data);
+                                        /* Regist callback of configuration reload  */
+int ico_ivi_conf_add_reload(void (*func)(void *data), void *data);
+                                        /* Remove callback of configuration reload  */
+int ico_ivi_conf_remove_reload(void (*func)(void *data), void *data);
+
+/* Hook chain(hook functions ordered by priority)   */
+#define ICO_IVI_HOOK_PRIORITY_FIRST     0   /* called first(ex. policy)             */
+#define ICO_IVI_HOOK_PRIORITY_DEFAULT   100 /* core plugins(ex. ico_window_mgr)     */
+#define ICO_IVI_HOOK_PRIORITY_LAST      200 /* called last(ex. telemetry)           */
+
+struct ico_ivi_hook {
+    int     priority;                       /* priority(smaller is called first)    */
+    void    (*func)(void);                  /* hook function(cast to real type)     */
+    void    *data;                          /* user data(last argument of function) */
+};
+struct ico_ivi_hook_chain {
+    int     num;                            /* number of hook functions             */
+    int     max;                            /* number of allocated entries          */
+    struct ico_ivi_hook *hook;              /* hook functions sorted by priority    */
+    int     next;                           /* index of next hook in iteration      */
+};
+                                        /* Add hook function to hook chain          */
+int ico_ivi_hook_add(struct ico_ivi_hook_chain *chain, const int priority,
+                     void (*func)(void), void *data);
+                                        /* Remove hook function from hook chain     */
+int ico_ivi_hook_remove(struct ico_ivi_hook_chain *chain, void (*func)(void), void *data);
+
+/* Iterate hook chain(hook function may add/remove hook, but must not  */
+/* iterate same chain recursively)                                       */
+#define ico_ivi_hook_for_each(pos,chain)    \
+    for ((chain)->next = 0;                 \
+         ((chain)->next < (chain)->num) &&  \
+             (((pos) = &(chain)->hook[(chain)->next++]) != NULL); )
+
+/* Runtime metrics                      */
+#define ICO_IVI_METRIC_COUNTER      1       /* counter(32bits, wrap around)         */
+#define ICO_IVI_METRIC_GAUGE        2       /* gauge(current value)                 */
+#define ICO_IVI_METRIC_HISTOGRAM    3       /* histogram(log2 buckets)              */
+#define ICO_IVI_METRIC_NAME_LEN     48      /* maximum length of metric name        */
+#define ICO_IVI_METRIC_BUCKETS      24      /* histogram buckets(n: 2^(n-1)..2^n-1) */
+
+struct ico_ivi_metric {
+    struct wl_list  link;                   /* link of registered metrics           */
+    char    name[ICO_IVI_METRIC_NAME_LEN];  /* metric name(plugin.name)             */
+    int     type;                           /* metric type(ICO_IVI_METRIC_xxx)      */
+    volatile int32_t    value;              /* counter/gauge value                  */
+    volatile uint64_t   sum;                /* sum of histogram samples             */
+    volatile uint32_t   count;              /* number of histogram samples          */
+    volatile uint32_t   max;                /* maximum histogram sample             */
+    volatile uint32_t   bucket[ICO_IVI_METRIC_BUCKETS];    /* histogram buckets     */
+};
+                                        /* Regist metric(same name returns same one)*/
+struct ico_ivi_metric *ico_ivi_metric_regist(const char *name, const int type);
+                                        /* Add sample to histogram metric           */
+void ico_ivi_metric_record(struct ico_ivi_metric *metric, const uint32_t sample);
+
+/* Update of counter and gauge(lock-free, NULL metric is ignored)   */
+#define ico_ivi_metric_add(metric,num)  \
+    { if (metric) {__sync_fetch_and_add(&(metric)->value, (num));} }
+#define ico_ivi_metric_set(metric,val)  \
+    { if (metric) {(metric)->value = (val);} }
+
 /* Debug Traces                         */
 /* Define for debug write               */
 #define UIFW_DEBUG_OUT  1   /* 1=Debug Print/0=No Debug Print           */
 
+/* Maximum debug level compiled in, traces of higher level are compiled out */
+/* (configure --with-trace-level=N)     */
+#ifndef UIFW_TRACE_LEVEL
 #if UIFW_DEBUG_OUT > 0
-#define uifw_trace(fmt,...)  \
-    { if (ico_ivi_debuglevel() >= 4) {weston_log("DBG>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
+#define UIFW_TRACE_LEVEL    4
 #else  /*UIFW_DEBUG_OUT*/
-#define uifw_trace(fmt,...)
+#define UIFW_TRACE_LEVEL    3
 #endif /*UIFW_DEBUG_OUT*/
+#endif /*UIFW_TRACE_LEVEL*/
+
+/* Branch prediction hints              */
+#ifdef __GNUC__
+#define uifw_likely(x)      __builtin_expect(!!(x), 1)
+#define uifw_unlikely(x)    __builtin_expect(!!(x), 0)
+#else  /*__GNUC__*/
+#define uifw_likely(x)      (x)
+#define uifw_unlikely(x)    (x)
+#endif /*__GNUC__*/
 
+/* Debug output level(ico_ivi_common), checked inline without function call  */
+extern int ico_ivi_debug_level;
+
+/* Debug write of the level is on(arguments are evaluated only if on)       */
+#define UIFW_DEBUG_ON(level)    \
+    (((level) <= UIFW_TRACE_LEVEL) && uifw_unlikely(ico_ivi_debug_level >= (level)))
+
+#define uifw_trace(fmt,...)  \
+    { if (UIFW_DEBUG_ON(4)) {weston_log("DBG>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
 #define uifw_info(fmt,...)  \
-    { if (ico_ivi_debuglevel() >= 3) {weston_log("INF>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
+    { if (UIFW_DEBUG_ON(3)) {weston_log("INF>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
 #define uifw_msg(fmt,...)  \
-    { if (ico_ivi_debuglevel() >= 3) {weston_log("INF>"fmt"\n",##__VA_ARGS__);} }
+    { if (UIFW_DEBUG_ON(3)) {weston_log("INF>"fmt"\n",##__VA_ARGS__);} }
 #define uifw_warn(fmt,...)  \
-    { if (ico_ivi_debuglevel() >= 2) {weston_log("WRN>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
+    { if (UIFW_DEBUG_ON(2)) {weston_log("WRN>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
 #define uifw_error(fmt,...)  \
-    { if (ico_ivi_debuglevel() >= 1) {weston_log("ERR>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
+    { if (UIFW_DEBUG_ON(1)) {weston_log("ERR>"fmt" (%s:%d)\n",##__VA_ARGS__,__FILE__,__LINE__);} }
+
+/* Binary Traces(ring buffer file, decode by ico_trace_decode) */
+/* Trace ring buffer(ico_ivi_common, NULL=binary trace off)   */
+extern struct ico_trace_header *ico_ivi_trace_ring;
+                                        /* Write binary trace record                */
+void ico_ivi_trace_write(const int id, const int nargs, ...);
+
+/* Number of arguments(0 to ICO_TRACE_MAXARGS)                  */
+#define UIFW_BTRACE_NARGS(...)  UIFW_BTRACE_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define UIFW_BTRACE_NARGS_(z, a1, a2, a3, a4, a5, a6, n, ...)   n
+
+/* Write binary trace(tracepoint id and integer arguments, no formatting)   */
+#define uifw_btrace(id,...)  \
+    { if (uifw_unlikely(ico_ivi_trace_ring != NULL)) \
+        {ico_ivi_trace_write(id, UIFW_BTRACE_NARGS(__VA_ARGS__), ##__VA_ARGS__);} }
+
+/* Event loop watchdog(dispatch time of each handler, including nested handlers)  */
+struct ico_ivi_watch {
+    const char  *name;                      /* handler name(plugin.handler)         */
+    struct wl_list  link;                   /* link of called handlers              */
+    int         id;                         /* handler id(0=not called yet)         */
+    uint32_t    count;                      /* number of calls in summary interval  */
+    uint32_t    stall;                      /* number of stalls in summary interval */
+    uint32_t    max;                        /* maximum time(usec) in interval       */
+    uint64_t    total;                      /* total time(usec) in interval         */
+};
+struct ico_ivi_watch_scope {
+    struct ico_ivi_watch *watch;            /* handler                              */
+    uint64_t    start;                      /* start time(usec, 0=watchdog disabled)*/
+    int         arg1;                       /* handler argument(for stall log)      */
+    int         arg2;                       /* handler argument(for stall log)      */
+};
+extern int  ico_ivi_watch_enable;
+                                        /* Start of handler(returns start time)     */
+uint64_t ico_ivi_watch_enter(struct ico_ivi_watch *watch);
+                                        /* End of handler(called at end of scope)   */
+void ico_ivi_watch_leave(struct ico_ivi_watch_scope *scope);
+                                        /* Remove handlers of unloading plugin      */
+void ico_ivi_watch_release(const void *addr);
+
+/* End of scope of uifw_watch(call ico_ivi_watch_leave only if watchdog enabled) */
+static inline void
+uifw_watch_cleanup(struct ico_ivi_watch_scope *scope)
+{
+    if (uifw_unlikely(scope->start != 0))   {
+        ico_ivi_watch_leave(scope);
+    }
+}
+
+/* Watch dispatch time of handler until return(put at end of local declarations)  */
+#define uifw_watch(name,a1,a2)  \
+    static struct ico_ivi_watch _uifw_watch = { name };   \
+    struct ico_ivi_watch_scope _uifw_watch_scope        \
+        __attribute__((cleanup(uifw_watch_cleanup))) =  \
+        { &_uifw_watch, uifw_unlikely(ico_ivi_watch_enable) ?  \
+              ico_ivi_watch_enter(&_uifw_watch) : 0, (int)(a1), (int)(a2) }
+
+/* Timer wheel(all timers share one timerfd, resolution 1ms)    */
+struct ico_ivi_timer {
+    struct wl_list  link;                   /* link of wheel slot or expired timers */
+    uint64_t    expire;                     /* expire time(ms, monotonic clock)     */
+    int         slot;                       /* wheel slot(-1=not in wheel)          */
+    void        (*func)(void *data);        /* expire callback                      */
+    void        *data;                      /* user data(callback parameter)        */
+};
+                                        /* Initialize timer(before first arm)       */
+void ico_ivi_timer_init(struct ico_ivi_timer *timer, void (*func)(void *data), void *data);
+                                        /* Arm timer(re-arm if armed, O(1))         */
+int ico_ivi_timer_arm(struct ico_ivi_timer *timer, const uint32_t msec);
+                                        /* Cancel timer(O(1))                       */
+void ico_ivi_timer_cancel(struct ico_ivi_timer *timer);
+
+/* Timer is armed and not expired yet   */
+#define ico_ivi_timer_is_armed(timer)   \
+    (((timer)->link.next != NULL) && (! wl_list_empty(&(timer)->link)))
 
 #endif  /*_ICO_IVI_COMMON_H_*/
 
@@ -47,6 +47,9 @@
 #include "ico_ivi_shell.h"
 #include "ico_ivi_shell-server-protocol.h"
 
+/* Plugins that must be loaded before this plugin    */
+ICO_PLUGIN_DEPENDS("ico_ivi_common.so");
+
 /* Layer management                 */
 struct  ivi_layer_list  {
     int     layer;                  /* Layer.ID                             */
@@ -71,6 +74,8 @@ struct ivi_shell {
                                             /* Pointer active shell surface */
     struct shell_surface *active_keyboard_shsurf;
                                             /* Keyboard active shell surface*/
+    struct ico_ivi_metric *m_restack;       /* metric: number of restacks   */
+    struct ico_ivi_metric *m_configure;     /* metric: configure round trip */
 };
 
 /* Surface type                     */
@@ -105,6 +110,9 @@ struct shell_surface {
     char    mapped;
     char    noconfigure;
     char    restrain;
+    char    restrain_commit;        /* client commit while restrain */
+    int     restrain_sx;            /* attach offset while restrain */
+    int     restrain_sy;
     struct ivi_layer_list *layer_list;
     struct wl_list        ivi_layer;
 
@@ -113,6 +121,7 @@ struct shell_surface {
         unsigned short  y;
         unsigned short  width;
         unsigned short  height;
+        uint32_t        time;       /* send time(usec, 0=not waiting)   */
     }       configure_app;
 
     struct {
@@ -141,18 +150,16 @@ static struct shell_surface *get_shell_surface(struct weston_surface *surface);
 static struct ivi_shell *shell_surface_get_shell(struct shell_surface *shsurf);
 static void ivi_shell_restack_ivi_layer(struct ivi_shell *shell,
                                         struct shell_surface *shsurf);
+static void shell_reload(void *data);
 
-static void (*shell_hook_bind)(struct wl_client *client) = NULL;
-static void (*shell_hook_unbind)(struct wl_client *client) = NULL;
-static void (*shell_hook_create)(struct wl_client *client, struct wl_resource *resource,
-                                 struct weston_surface *surface,
-                                 struct shell_surface *shsurf) = NULL;
-static void (*shell_hook_destroy)(struct weston_surface *surface) = NULL;
-static void (*shell_hook_map)(struct weston_surface *surface, int32_t *width,
-                              int32_t *height, int32_t *sx, int32_t *sy) = NULL;
-static void (*shell_hook_change)(struct weston_surface *surface, const int to,
-                                 const int manager) = NULL;
-static void (*shell_hook_select)(struct weston_surface *surface) = NULL;
+/* hook chains                  */
+static struct ico_ivi_hook_chain shell_hook_bind = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_unbind = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_create = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_destroy = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_map = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_change = { 0, 0, NULL, 0 };
+static struct ico_ivi_hook_chain shell_hook_select = { 0, 0, NULL, 0 };
 
 
 /*--------------------------------------------------------------------------*/
@@ -166,26 +173,18 @@ static void (*shell_hook_select)(struct weston_surface *surface) = NULL;
 static void
 shell_configuration(struct ivi_shell *shell)
 {
-    int     config_fd;
-    char    *win_animation = NULL;
-    int     win_animation_time = 800;
-    int     win_animation_fps = 15;
-
-    struct config_key shell_keys[] = {
-        { "animation",          CONFIG_KEY_STRING, &win_animation },
-        { "animation_time",     CONFIG_KEY_INTEGER, &win_animation_time },
-        { "animation_fps",      CONFIG_KEY_INTEGER, &win_animation_fps },
-        { "visible_on_create",  CONFIG_KEY_INTEGER, &shell->win_visible_on_create },
-    };
-
-    struct config_section cs[] = {
-        { "shell", shell_keys, ARRAY_LENGTH(shell_keys), NULL },
-    };
-
-    config_fd = open_config_file(ICO_IVI_PLUGIN_CONFIG);
-    parse_config_file(config_fd, cs, ARRAY_LENGTH(cs), shell);
-    close(config_fd);
-
+    const char  *win_animation;
+    int     win_animation_time;
+    int     win_animation_fps;
+
+    /* get configuration from cache of ico_ivi_common   */
+    win_animation = ico_ivi_conf_string("shell", "animation", NULL);
+    win_animation_time = ico_ivi_conf_integer("shell", "animation_time", 800);
+    win_animation_fps = ico_ivi_conf_integer("shell", "animation_fps", 15);
+    shell->win_visible_on_create = ico_ivi_conf_integer("shell", "visible_on_create",
+                                                        shell->win_visible_on_create);
+
+    memset(shell->win_animation, 0, sizeof(shell->win_animation));
     if (win_animation)  {
         strncpy(shell->win_animation, win_animation, sizeof(shell->win_animation)-1);
     }
@@ -199,6 +198,20 @@ shell_configuration(struct ivi_shell *shell)
               shell->win_visible_on_create, ico_ivi_debuglevel());
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   shell_reload: configuration file changed, reconfigure ico_ivi_shell
+ *
+ * @param[in]   data    ico_ivi_shell static table area
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+shell_reload(void *data)
+{
+    shell_configuration((struct ivi_shell *)data);
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   send_configure: send configure(resize) event to client applicstion
@@ -369,6 +382,7 @@ static void
 shell_surface_set_toplevel(struct wl_client *client, struct wl_resource *resource)
 {
     struct shell_surface *shsurf = resource->data;
+    uifw_watch("shell.set_toplevel", resource, 0);
 
     uifw_trace("shell_surface_set_toplevel: Set TopLevel[%08x] surf=%08x",
                (int)shsurf, (int)shsurf->surface);
@@ -420,6 +434,7 @@ shell_surface_set_transient(struct wl_client *client, struct wl_resource *resour
 {
     struct shell_surface *shsurf = resource->data;
     struct weston_surface *parent = parent_resource->data;
+    uifw_watch("shell.set_transient", resource, flags);
 
     uifw_trace("shell_surface_set_transient: Set Transient[%08x] surf=%08x",
                (int)shsurf, (int)shsurf->surface);
@@ -603,6 +618,9 @@ shell_surface_get_shell(struct shell_surface *shsurf)
 static void
 destroy_shell_surface(struct shell_surface *shsurf)
 {
+    struct ico_ivi_hook *hook;
+    uifw_watch("shell.destroy_shell_surface", shsurf, 0);
+
     uifw_trace("destroy_shell_surface: Enter[%08x]", (int)shsurf);
 
     if (shsurf->visible != FALSE)   {
@@ -612,11 +630,12 @@ destroy_shell_surface(struct shell_surface *shsurf)
 
     wl_list_remove(&shsurf->ivi_layer);
 
-    if (shell_hook_destroy) {
-        /* call sufrace destory hook routine    */
+    /* call sufrace destory hook routine    */
+    ico_ivi_hook_for_each (hook, &shell_hook_destroy)   {
         uifw_trace("destroy_shell_surface: call ivi_shell_hook_destroy(%08x)",
                    (int)shsurf->surface);
-        (void) (*shell_hook_destroy) (shsurf->surface);
+        (*(void (*)(struct weston_surface *, void *))hook->func)
+            (shsurf->surface, hook->data);
         uifw_trace("destroy_shell_surface: ret");
     }
 
@@ -679,6 +698,25 @@ shell_handle_surface_destroy(struct wl_listener *listener, void *data)
 static void
 shell_surface_configure(struct weston_surface *, int32_t, int32_t);
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   shell_usec: get monotonic time for configure round trip metric
+ *
+ * @param       none
+ * @return      time(usec, never 0)
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+shell_usec(void)
+{
+    struct timespec ts;
+    uint32_t        usec;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    usec = (uint32_t)ts.tv_sec * 1000000u + (uint32_t)(ts.tv_nsec / 1000);
+    return usec ? usec : 1;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   get_shell_surface: get shell surface
@@ -776,6 +814,8 @@ shell_get_shell_surface(struct wl_client *client, struct wl_resource *resource,
     struct weston_surface *surface = surface_resource->data;
     struct ivi_shell *shell = resource->data;
     struct shell_surface *shsurf;
+    struct ico_ivi_hook *hook;
+    uifw_watch("shell.get_shell_surface", client, id);
 
     if (get_shell_surface(surface)) {
         wl_resource_post_error(surface_resource,
@@ -809,11 +849,13 @@ shell_get_shell_surface(struct wl_client *client, struct wl_resource *resource,
     uifw_trace("shell_get_shell_surface: Init shsurf(%08x) weston_surf=%08x",
                (int)shsurf, (int)surface);
 
-    if (shell_hook_create)  {
-        /* call surface create hook routine     */
+    /* call surface create hook routine     */
+    ico_ivi_hook_for_each (hook, &shell_hook_create)    {
         uifw_trace("shell_get_shell_surface: call ivi_shell_hook_create(%08x,,%08x,%08x)",
                    (int)client, (int)surface, (int)shsurf);
-        (void) (*shell_hook_create)(client, resource, surface, shsurf);
+        (*(void (*)(struct wl_client *, struct wl_resource *, struct weston_surface *,
+                    struct shell_surface *, void *))hook->func)
+            (client, resource, surface, shsurf, hook->data);
         uifw_trace("shell_get_shell_surface: ret  ivi_shell_hook_create");
     }
     uifw_trace("shell_get_shell_surface: Leave");
@@ -880,6 +922,7 @@ map(struct ivi_shell *shell, struct weston_surface *surface,
     struct shell_surface *shsurf = get_shell_surface(surface);
     enum shell_surface_type surface_type = shsurf->type;
     struct weston_surface *parent;
+    struct ico_ivi_hook *hook;
 
     uifw_trace("map: Enter(%08x) sx/sy=%d/%d, w/h=%d/%d",
                (int)surface, ((int)sx)/256, ((int)sy)/256, width, height);
@@ -935,19 +978,22 @@ map(struct ivi_shell *shell, struct weston_surface *surface,
         ivi_shell_restack_ivi_layer(shell, shsurf);
     }
 
-    if (shell_hook_map) {
-        /* Surface map hook routine         */
+    /* Surface map hook routine(next hook gets changed position and size)   */
+    ico_ivi_hook_for_each (hook, &shell_hook_map)   {
         uifw_trace("map: call ivi_shell_hook_map(%08x, x/y=%d/%d, w/h=%d/%d)",
                    (int)surface, sx, sy, width, height);
-        (void) (*shell_hook_map) (surface, &width, &height, &sx, &sy);
+        (*(void (*)(struct weston_surface *, int32_t *, int32_t *, int32_t *,
+                    int32_t *, void *))hook->func)
+            (surface, &width, &height, &sx, &sy, hook->data);
         uifw_trace("map: ret  ivi_shell_hook_map(%08x, x/y=%d/%d, w/h=%d/%d)",
                    (int)surface, sx, sy, width, height);
     }
 
-    if (shell_hook_change)  {
-        /* Surface change hook routine      */
+    /* Surface change hook routine      */
+    ico_ivi_hook_for_each (hook, &shell_hook_change)    {
         uifw_trace("map: call ivi_shell_hook_change(%08x)", (int)surface);
-        (void) (*shell_hook_change)(surface, -1, 1);    /* Send to Manager  */
+        (*(void (*)(struct weston_surface *, const int, const int, void *))hook->func)
+            (surface, -1, 1, hook->data);               /* Send to Manager  */
         uifw_trace("map: ret  ivi_shell_hook_change")
     }
     uifw_trace("map: Leave");
@@ -1015,18 +1061,32 @@ shell_surface_configure(struct weston_surface *es, int32_t sx, int32_t sy)
     int     type_changed = 0;
     int     num_mgr;
     int     dx, dy, dw, dh;
+    uifw_watch("shell.surface_configure", es, ((uint32_t)sx << 16) | (sy & 0x0ffff));
 
     uifw_trace("shell_surface_configure: Enter(surf=%08x out=%08x buf=%08x)",
                (int)es, (int)es->output, (int)es->buffer);
+    uifw_btrace(ICO_TP_SHELL_CONFIGURE, (int)es, sx, sy);
 
     if (! es->buffer)   {
         uifw_trace("shell_surface_configure: Leave(no buffer)");
         return;
     }
     if (shsurf->restrain)   {
+        /* configure at end of restrain with all offsets    */
+        shsurf->restrain_commit = 1;
+        shsurf->restrain_sx += sx;
+        shsurf->restrain_sy += sy;
         uifw_trace("shell_surface_configure: Leave(restrain)");
         return;
     }
+    if ((shsurf->configure_app.time != 0) &&
+        (es->buffer->width == shsurf->configure_app.width) &&
+        (es->buffer->height == shsurf->configure_app.height))  {
+        /* application answered to configure event  */
+        ico_ivi_metric_record(shell->m_configure,
+                              shell_usec() - shsurf->configure_app.time);
+        shsurf->configure_app.time = 0;
+    }
 
     if (shsurf->next_type != SHELL_SURFACE_NONE &&
         shsurf->type != shsurf->next_type) {
@@ -1138,6 +1198,8 @@ bind_shell(struct wl_client *client, void *data, uint32_t version, uint32_t id)
 {
     struct ivi_shell *shell = data;
     struct wl_resource *resource;
+    struct ico_ivi_hook *hook;
+    uifw_watch("shell.bind", client, id);
 
     uifw_trace("bind_shell: client=%08x id=%d", (int)client, (int)id);
 
@@ -1146,8 +1208,8 @@ bind_shell(struct wl_client *client, void *data, uint32_t version, uint32_t id)
 
     resource->destroy = unbind_shell;
 
-    if (shell_hook_bind)    {
-        (*shell_hook_bind)(client);
+    ico_ivi_hook_for_each (hook, &shell_hook_bind)  {
+        (*(void (*)(struct wl_client *, void *))hook->func)(client, hook->data);
     }
 }
 
@@ -1162,10 +1224,13 @@ bind_shell(struct wl_client *client, void *data, uint32_t version, uint32_t id)
 static void
 unbind_shell(struct wl_resource *resource)
 {
+    struct ico_ivi_hook *hook;
+    uifw_watch("shell.unbind", resource, 0);
+
     uifw_trace("unbind_shell");
 
-    if (shell_hook_unbind)  {
-        (*shell_hook_unbind)(resource->client);
+    ico_ivi_hook_for_each (hook, &shell_hook_unbind)    {
+        (*(void (*)(struct wl_client *, void *))hook->func)(resource->client, hook->data);
     }
     free(resource);
 }
@@ -1202,6 +1267,7 @@ bind_ivi_shell(struct wl_client *client,
 {
     struct ivi_shell *shell = data;
     struct wl_resource *resource;
+    uifw_watch("shell.bind_ivi_shell", client, id);
 
     resource = wl_client_add_object(client, &ico_ivi_shell_interface,
                                     NULL, id, shell);
@@ -1246,8 +1312,11 @@ ivi_shell_restack_ivi_layer(struct ivi_shell *shell, struct shell_surface *shsur
     struct shell_surface  *es;
     struct ivi_layer_list *el;
     float   new_x, new_y;
+    uifw_watch("shell.restack", shsurf, 0);
 
     uifw_trace("ivi_shell_restack_ivi_layer: Enter[%08x]", (int)shsurf);
+    uifw_btrace(ICO_TP_SHELL_RESTACK, (int)shsurf);
+    ico_ivi_metric_add(shell->m_restack, 1);
 
     /* make compositor surface list     */
     wl_list_init(&shell->surface.surface_list);
@@ -1465,7 +1534,18 @@ ivi_shell_restrain_configure(struct shell_surface *shsurf, const int restrain)
     shsurf->restrain = restrain;
 
     if (restrain == 0)  {
-        shell_surface_configure(shsurf->surface, shsurf->geometry_x, shsurf->geometry_y);
+        if (shsurf->restrain_commit)    {
+            /* client commit while restrain     */
+            shsurf->restrain_commit = 0;
+            shell_surface_configure(shsurf->surface,
+                                    shsurf->restrain_sx, shsurf->restrain_sy);
+            shsurf->restrain_sx = 0;
+            shsurf->restrain_sy = 0;
+        }
+        else    {
+            shell_surface_configure(shsurf->surface,
+                                    shsurf->geometry_x, shsurf->geometry_y);
+        }
         ivi_shell_restack_ivi_layer(shell_surface_get_shell(shsurf), shsurf);
     }
 }
@@ -1523,6 +1603,9 @@ click_to_activate_binding(struct wl_seat *seat, uint32_t time, uint32_t button,
     struct ivi_shell *shell = data;
     struct shell_surface *shsurf;
     struct weston_surface *surface;
+    struct ico_ivi_hook *hook;
+    int     handled;
+    uifw_watch("shell.click_to_activate", seat, button);
 
     if ((! seat) || (! seat->pointer) || (! seat->pointer->focus))  {
         uifw_trace("click_to_activate_binding: Surface dose not exist");
@@ -1539,18 +1622,23 @@ click_to_activate_binding(struct wl_seat *seat, uint32_t time, uint32_t button,
                        (int)shsurf);
         }
         else if (shell->active_pointer_shsurf != shsurf)    {
-            if (shell_hook_select) {
-                /* surface select hook routine      */
-                uifw_trace("click_to_activate_binding: call ivi_shell_hook_select[%08x]",
-                           (int)shsurf);
-                (void) (*shell_hook_select)(surface);
-                uifw_trace("click_to_activate_binding: ret  ivi_shell_hook_select")
+            /* surface select hook routine, all hooks are called    */
+            handled = 0;
+            ico_ivi_hook_for_each (hook, &shell_hook_select)    {
+                uifw_trace("click_to_activate_binding: call ivi_shell_hook_select"
+                           "[%08x]", (int)shsurf);
+                if ((*(int (*)(struct weston_surface *, void *))hook->func)
+                        (surface, hook->data))  {
+                    handled = 1;
+                }
+                uifw_trace("click_to_activate_binding: ret  ivi_shell_hook_select(%d)",
+                           handled);
             }
-            else    {
+            if (! handled)  {
                 ivi_shell_set_active(shsurf,
                                      ICO_IVI_SHELL_ACTIVE_POINTER |
                                          ICO_IVI_SHELL_ACTIVE_KEYBOARD);
-                uifw_trace("click_to_activate_binding: no hook[%08x]", (int)shsurf);
+                uifw_trace("click_to_activate_binding: not handled[%08x]", (int)shsurf);
             }
         }
         else    {
@@ -1788,6 +1876,7 @@ ivi_shell_send_configure(struct shell_surface *shsurf, const int id,
                shsurf->configure_app.width, shsurf->configure_app.height);
     shsurf->configure_app.width = width;
     shsurf->configure_app.height = height;
+    shsurf->configure_app.time = shell_usec();
 
     wl_shell_surface_send_configure(&shsurf->resource,
                                     WL_SHELL_SURFACE_RESIZE_BOTTOM_RIGHT,
@@ -1972,111 +2061,253 @@ ivi_shell_surface_configure(struct shell_surface *shsurf, const int x,
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_bind: regist hook function for shell bind
+ * @brief   ivi_shell_add_hook_bind: add hook function for shell bind
  *
- * @param[in]   hook_bind       hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_bind       hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_bind(void (*hook_bind)(struct wl_client *client))
+WL_EXPORT int
+ivi_shell_add_hook_bind(const int priority,
+                        void (*hook_bind)(struct wl_client *client, void *data),
+                        void *data)
 {
-    uifw_trace("ivi_shell_hook_bind: Hook %08x", (int)hook_bind);
-    shell_hook_bind = hook_bind;
+    return ico_ivi_hook_add(&shell_hook_bind, priority, (void (*)(void))hook_bind, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_unbind: regist hook function for shell unbind
+ * @brief   ivi_shell_remove_hook_bind: remove hook function for shell bind
  *
- * @param[in]   hook_unbind     hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   hook_bind       hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_bind)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_unbind(void (*hook_unbind)(struct wl_client *client))
+WL_EXPORT int
+ivi_shell_remove_hook_bind(void (*hook_bind)(struct wl_client *client, void *data),
+                           void *data)
 {
-    uifw_trace("ivi_shell_hook_unbind: Hook %08x", (int)hook_unbind);
-    shell_hook_unbind = hook_unbind;
+    return ico_ivi_hook_remove(&shell_hook_bind, (void (*)(void))hook_bind, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_create: regist hook function for create shell surface
+ * @brief   ivi_shell_add_hook_unbind: add hook function for shell unbind
  *
- * @param[in]   hook_create     hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_unbind     hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_create(void (*hook_create)(struct wl_client *client,
-                      struct wl_resource *resource, struct weston_surface *surface,
-                      struct shell_surface *shsurf))
+WL_EXPORT int
+ivi_shell_add_hook_unbind(const int priority,
+                          void (*hook_unbind)(struct wl_client *client, void *data),
+                          void *data)
 {
-    uifw_trace("ivi_shell_hook_create: Hook %08x", (int)hook_create);
-    shell_hook_create = hook_create;
+    return ico_ivi_hook_add(&shell_hook_unbind, priority, (void (*)(void))hook_unbind, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_destroy: regist hook function for destroy shell surface
+ * @brief   ivi_shell_remove_hook_unbind: remove hook function for shell unbind
  *
- * @param[in]   hook_destroy    hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   hook_unbind     hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_unbind)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_destroy(void (*hook_destroy)(struct weston_surface *surface))
+WL_EXPORT int
+ivi_shell_remove_hook_unbind(void (*hook_unbind)(struct wl_client *client, void *data),
+                             void *data)
 {
-    uifw_trace("ivi_shell_hook_destroy: Hook %08x", (int)hook_destroy);
-    shell_hook_destroy = hook_destroy;
+    return ico_ivi_hook_remove(&shell_hook_unbind, (void (*)(void))hook_unbind, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_map: regist hook function for map shell surface
+ * @brief   ivi_shell_add_hook_create: add hook function for create shell surface
  *
- * @param[in]   hook_map        hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_create     hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_map(void (*hook_map)(struct weston_surface *surface,
-                        int32_t *width, int32_t *height, int32_t *sx, int32_t *sy))
+WL_EXPORT int
+ivi_shell_add_hook_create(const int priority,
+                          void (*hook_create)(struct wl_client *client,
+                              struct wl_resource *resource,
+                              struct weston_surface *surface,
+                              struct shell_surface *shsurf, void *data),
+                          void *data)
 {
-    uifw_trace("ivi_shell_hook_map: Hook %08x", (int)hook_map);
-    shell_hook_map = hook_map;
+    return ico_ivi_hook_add(&shell_hook_create, priority, (void (*)(void))hook_create, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_change: regist hook function for change shell surface
+ * @brief   ivi_shell_remove_hook_create: remove hook function for create shell surface
  *
- * @param[in]   hook_change     hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   hook_create     hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_create)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_change(void (*hook_change)(struct weston_surface *surface,
-                                          const int to, const int manager))
+WL_EXPORT int
+ivi_shell_remove_hook_create(void (*hook_create)(struct wl_client *client,
+                                     struct wl_resource *resource,
+                                     struct weston_surface *surface,
+                                     struct shell_surface *shsurf, void *data),
+                             void *data)
 {
-    uifw_trace("ivi_shell_hook_change: Hook %08x", (int)hook_change);
-    shell_hook_change = hook_change;
+    return ico_ivi_hook_remove(&shell_hook_create, (void (*)(void))hook_create, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ivi_shell_hook_select: regist hook function for select(active) shell surface
+ * @brief   ivi_shell_add_hook_destroy: add hook function for destroy shell surface
  *
- * @param[in]   hook_select     hook function(if NULL, reset hook function)
- * @return      none
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_destroy    hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ivi_shell_hook_select(void (*hook_select)(struct weston_surface *surface))
+WL_EXPORT int
+ivi_shell_add_hook_destroy(const int priority,
+                           void (*hook_destroy)(struct weston_surface *surface, void *data),
+                           void *data)
 {
-    uifw_trace("ivi_shell_hook_select: Hook %08x", (int)hook_select);
-    shell_hook_select = hook_select;
+    return ico_ivi_hook_add(&shell_hook_destroy, priority, (void (*)(void))hook_destroy, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_remove_hook_destroy: remove hook function for destroy shell surface
+ *
+ * @param[in]   hook_destroy    hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_destroy)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_remove_hook_destroy(void (*hook_destroy)(struct weston_surface *surface, void *data),
+                              void *data)
+{
+    return ico_ivi_hook_remove(&shell_hook_destroy, (void (*)(void))hook_destroy, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_add_hook_map: add hook function for map shell surface
+ *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_map        hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_add_hook_map(const int priority,
+                       void (*hook_map)(struct weston_surface *surface,
+                           int32_t *width, int32_t *height,
+                           int32_t *sx, int32_t *sy, void *data),
+                       void *data)
+{
+    return ico_ivi_hook_add(&shell_hook_map, priority, (void (*)(void))hook_map, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_remove_hook_map: remove hook function for map shell surface
+ *
+ * @param[in]   hook_map        hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_map)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_remove_hook_map(void (*hook_map)(struct weston_surface *surface,
+                                  int32_t *width, int32_t *height,
+                                  int32_t *sx, int32_t *sy, void *data),
+                          void *data)
+{
+    return ico_ivi_hook_remove(&shell_hook_map, (void (*)(void))hook_map, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_add_hook_change: add hook function for change shell surface
+ *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_change     hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_add_hook_change(const int priority,
+                          void (*hook_change)(struct weston_surface *surface,
+                              const int to, const int manager, void *data),
+                          void *data)
+{
+    return ico_ivi_hook_add(&shell_hook_change, priority, (void (*)(void))hook_change, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_remove_hook_change: remove hook function for change shell surface
+ *
+ * @param[in]   hook_change     hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_change)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_remove_hook_change(void (*hook_change)(struct weston_surface *surface,
+                                     const int to, const int manager, void *data),
+                             void *data)
+{
+    return ico_ivi_hook_remove(&shell_hook_change, (void (*)(void))hook_change, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_add_hook_select: add hook function for select(active) shell surface
+ *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_select     hook function(return not 0 if hook handled select,
+ *                              shell does not activate surface)
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_add_hook_select(const int priority,
+                          int (*hook_select)(struct weston_surface *surface, void *data),
+                          void *data)
+{
+    return ico_ivi_hook_add(&shell_hook_select, priority, (void (*)(void))hook_select, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ivi_shell_remove_hook_select: remove hook function for select(active) shell surface
+ *
+ * @param[in]   hook_select     hook function
+ * @param[in]   data            user data(same as ivi_shell_add_hook_select)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ivi_shell_remove_hook_select(int (*hook_select)(struct weston_surface *surface, void *data),
+                             void *data)
+{
+    return ico_ivi_hook_remove(&shell_hook_select, (void (*)(void))hook_select, data);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -2119,6 +2350,11 @@ module_init(struct weston_compositor *ec)
                (int)shell->ivi_layer.link.next, (int)shell->ivi_layer.link.prev);
 
     shell_configuration(shell);
+    ico_ivi_conf_add_reload(shell_reload, shell);
+
+    shell->m_restack = ico_ivi_metric_regist("shell.restacks", ICO_IVI_METRIC_COUNTER);
+    shell->m_configure = ico_ivi_metric_regist("shell.configure_usec",
+                                               ICO_IVI_METRIC_HISTOGRAM);
 
     if (wl_display_add_global(ec->wl_display, &wl_shell_interface, shell, bind_shell)
             == NULL)    {
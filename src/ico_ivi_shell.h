@@ -61,26 +61,83 @@ void ivi_shell_restrain_configure(struct shell_surface *shsurf, const int restra
 int ivi_shell_is_restrain(struct shell_surface *shsurf);
 const char *ivi_shell_default_animation(int *msec, int *fps);
 
-/* Prototypr for hook routine           */
-void ivi_shell_hook_bind(void (*hook_bind)(struct wl_client *client));
-void ivi_shell_hook_unbind(void (*hook_unbind)(struct wl_client *client));
-void ivi_shell_hook_create(void (*hook_create)(struct wl_client *client,
-                            struct wl_resource *resource, struct weston_surface *surface,
-                            struct shell_surface *shsurf));
-void ivi_shell_hook_destroy(void (*hook_destroy)(struct weston_surface *surface));
-void ivi_shell_hook_map(void (*hook_map)(struct weston_surface *surface,
-                            int32_t *width, int32_t *height, int32_t *sx, int32_t *sy));
-void ivi_shell_hook_change(void (*hook_change)(struct weston_surface *surface,
-                            const int to, const int manager));
-void ivi_shell_hook_select(void (*hook_select)(struct weston_surface *surface));
+/* Prototype for hook chain(priority is ICO_IVI_HOOK_PRIORITY_xxx,       */
+/* data is passed to last argument of hook function)                     */
+int ivi_shell_add_hook_bind(const int priority,
+                            void (*hook_bind)(struct wl_client *client, void *data),
+                            void *data);
+int ivi_shell_remove_hook_bind(void (*hook_bind)(struct wl_client *client, void *data),
+                               void *data);
+int ivi_shell_add_hook_unbind(const int priority,
+                              void (*hook_unbind)(struct wl_client *client, void *data),
+                              void *data);
+int ivi_shell_remove_hook_unbind(void (*hook_unbind)(struct wl_client *client, void *data),
+                                 void *data);
+int ivi_shell_add_hook_create(const int priority,
+                              void (*hook_create)(struct wl_client *client,
+                                  struct wl_resource *resource,
+                                  struct weston_surface *surface,
+                                  struct shell_surface *shsurf, void *data),
+                              void *data);
+int ivi_shell_remove_hook_create(void (*hook_create)(struct wl_client *client,
+                                     struct wl_resource *resource,
+                                     struct weston_surface *surface,
+                                     struct shell_surface *shsurf, void *data),
+                                 void *data);
+int ivi_shell_add_hook_destroy(const int priority,
+                               void (*hook_destroy)(struct weston_surface *surface,
+                                                    void *data),
+                               void *data);
+int ivi_shell_remove_hook_destroy(void (*hook_destroy)(struct weston_surface *surface,
+                                                       void *data),
+                                  void *data);
+int ivi_shell_add_hook_map(const int priority,
+                           void (*hook_map)(struct weston_surface *surface,
+                               int32_t *width, int32_t *height,
+                               int32_t *sx, int32_t *sy, void *data),
+                           void *data);
+int ivi_shell_remove_hook_map(void (*hook_map)(struct weston_surface *surface,
+                                  int32_t *width, int32_t *height,
+                                  int32_t *sx, int32_t *sy, void *data),
+                              void *data);
+int ivi_shell_add_hook_change(const int priority,
+                              void (*hook_change)(struct weston_surface *surface,
+                                  const int to, const int manager, void *data),
+                              void *data);
+int ivi_shell_remove_hook_change(void (*hook_change)(struct weston_surface *surface,
+                                     const int to, const int manager, void *data),
+                                 void *data);
+int ivi_shell_add_hook_select(const int priority,
+                              int (*hook_select)(struct weston_surface *surface,
+                                                  void *data),
+                              void *data);
+int ivi_shell_remove_hook_select(int (*hook_select)(struct weston_surface *surface,
+                                                     void *data),
+                                 void *data);
 
-/* Prototype for hook of Multi Input Manager    */
-void ico_win_mgr_hook_set_user(void (*hook_set_user)(struct wl_client *client,
-                                                    const char *appid));
-void ico_win_mgr_hook_create(void (*hook_create)(struct wl_client *client,
-                                                 struct weston_surface *surface,
-                                                 int surfaceId,
-                                                 const char *appid));
-void ico_win_mgr_hook_destroy(void (*hook_destroy)(struct weston_surface *surface));
+/* Prototype for hook chain of Multi Input Manager  */
+int ico_win_mgr_add_hook_set_user(const int priority,
+                                  void (*hook_set_user)(struct wl_client *client,
+                                      const char *appid, void *data),
+                                  void *data);
+int ico_win_mgr_remove_hook_set_user(void (*hook_set_user)(struct wl_client *client,
+                                         const char *appid, void *data),
+                                     void *data);
+int ico_win_mgr_add_hook_create(const int priority,
+                                void (*hook_create)(struct wl_client *client,
+                                    struct weston_surface *surface, int surfaceId,
+                                    const char *appid, void *data),
+                                void *data);
+int ico_win_mgr_remove_hook_create(void (*hook_create)(struct wl_client *client,
+                                       struct weston_surface *surface, int surfaceId,
+                                       const char *appid, void *data),
+                                   void *data);
+int ico_win_mgr_add_hook_destroy(const int priority,
+                                 void (*hook_destroy)(struct weston_surface *surface,
+                                                      void *data),
+                                 void *data);
+int ico_win_mgr_remove_hook_destroy(void (*hook_destroy)(struct weston_surface *surface,
+                                                         void *data),
+                                    void *data);
 
 #endif  /*_ICO_IVI_SHELL_H_*/
@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2010-2011 Intel Corporation
+ * Copyright © 2008-2011 Kristian Høgsberg
+ * Copyright © 2013 TOYOTA MOTOR CORPORATION.
+ *
+ * Permission to use, copy, modify, distribute, and sell this software and
+ * its documentation for any purpose is hereby granted without fee, provided
+ * that the above copyright notice appear in all copies and that both that
+ * copyright notice and this permission notice appear in supporting
+ * documentation, and that the name of the copyright holders not be used in
+ * advertising or publicity pertaining to distribution of the software
+ * without specific, written prior permission.  The copyright holders make
+ * no representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ *
+ * THE COPYRIGHT HOLDERS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS
+ * SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS, IN NO EVENT SHALL THE COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER
+ * RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF
+ * CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+/**
+ * @brief   Binary trace ring buffer format and tracepoints
+ *          (shared by plugins and the offline decoder ico_trace_decode)
+ *
+ * @date    Oct-18-2026
+ */
+
+#ifndef _ICO_IVI_TRACE_H_
+#define _ICO_IVI_TRACE_H_
+
+#include <stdint.h>
+
+/* Trace file                           */
+#define ICO_TRACE_MAGIC         0x4f434954  /* "TICO"                               */
+#define ICO_TRACE_VERSION       1           /* version of trace file format         */
+#define ICO_TRACE_MAXARGS       6           /* maximum arguments of a record        */
+#define ICO_TRACE_RECORDS       4096        /* default number of records(2^n)       */
+
+/* Trace file header(head of the file, records follow) */
+struct ico_trace_header {
+    uint32_t    magic;                      /* ICO_TRACE_MAGIC                      */
+    uint32_t    version;                    /* ICO_TRACE_VERSION                    */
+    uint32_t    hdrsize;                    /* size of this header                  */
+    uint32_t    recsize;                    /* size of a record                     */
+    uint32_t    nrecord;                    /* number of records(2^n)               */
+    volatile uint32_t head;                 /* next record sequence number          */
+    uint64_t    basetime;                   /* CLOCK_MONOTONIC(usec) at start       */
+};
+
+/* Trace record                         */
+struct ico_trace_record {
+    volatile uint32_t seq;                  /* sequence number + 1(0=writing)       */
+    uint16_t    id;                         /* tracepoint id                        */
+    uint16_t    nargs;                      /* number of arguments                  */
+    uint64_t    time;                       /* CLOCK_MONOTONIC(usec)                */
+    int32_t     arg[ICO_TRACE_MAXARGS];     /* arguments                            */
+};
+
+/* Tracepoints(id, name, format of arguments) */
+#define ICO_TRACE_POINTS(_)    \
+    _(ICO_TP_SHELL_CONFIGURE,   "shell_surface_configure",  "surf=%08x sx=%d sy=%d")  \
+    _(ICO_TP_SHELL_RESTACK,     "ivi_shell_restack_ivi_layer", "shsurf=%08x")    \
+    _(ICO_TP_WINMGR_SEND,       "ico_win_mgr_send_to_mgr",  \
+                                "event=%d surf=%08x p1=%d p2=%d p3=%d p4=%d")   \
+    _(ICO_TP_ANIMA_SLIDE,       "animation_slide",  "usurf=%08x count=%d par=%d state=%d") \
+    _(ICO_TP_ANIMA_FADE,        "animation_fade",   "usurf=%08x count=%d par=%d state=%d") \
+    _(ICO_TP_INPUT_EVENT,       "ico_device_input_event",   \
+                                "time=%u input=%d code=%d state=%d nroute=%d") \
+    _(ICO_TP_WATCH_STALL,       "ico_ivi_watch stall",  \
+                                "handler=%d usec=%u arg1=%08x arg2=%08x")
+
+#define ICO_TRACE_ENUM(id, name, format)    id,
+enum ico_trace_point {
+    ICO_TRACE_POINTS(ICO_TRACE_ENUM)
+    ICO_TP_MAX
+};
+#undef ICO_TRACE_ENUM
+
+#endif  /*_ICO_IVI_TRACE_H_*/
+
@@ -25,6 +25,9 @@
  * @brief   Weston(Wayland) Plugin Loader
  * @brief   Load the Weston plugins, because plugin loader of main body of Weston
  * @brief   cannot use other plugin functions by a other plugin.
+ * @brief   Plugins are loaded in order of the dependencies which each plugin
+ * @brief   declares by ICO_PLUGIN_DEPENDS, and the load timeline is logged.
+ * @brief   Reloadable plugin(exports module_exit) is reloaded when its file replaced.
  *
  * @date    Feb-08-2013
  */
@@ -36,39 +39,107 @@
 #include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
 #include <sys/time.h>
+#include <sys/inotify.h>
 #include <time.h>
 
 #include <weston/compositor.h>
 #include "ico_ivi_common.h"
 
+/* Plugin module table                      */
+#define ICO_PLUGIN_MAX_MODULES  32          /* maximum number of plugin modules     */
+#define ICO_PLUGIN_PATH_LEN     256         /* maximum length of module path        */
+#define ICO_PLUGIN_NAME_LEN     64          /* maximum length of module file name   */
+#define ICO_PLUGIN_DEPENDS_LEN  256         /* maximum length of dependency list    */
+#define ICO_PLUGIN_RELOAD_DELAY 200         /* delay from file replaced to reload(ms)*/
+
+#define ICO_PLUGIN_PENDING      0           /* not loaded yet                       */
+#define ICO_PLUGIN_LOADED       1           /* loaded and initialized               */
+#define ICO_PLUGIN_FAILED       2           /* load error                           */
+#define ICO_PLUGIN_SKIPPED      3           /* skipped, dependent plugin failed     */
+
+struct plugin_module {
+    char    path[ICO_PLUGIN_PATH_LEN];      /* file path of plugin module           */
+    char    name[ICO_PLUGIN_NAME_LEN];      /* file name of plugin module           */
+    char    depends[ICO_PLUGIN_DEPENDS_LEN];/* dependency list(ICO_PLUGIN_DEPENDS)  */
+    int     state;                          /* load state(ICO_PLUGIN_xxx)           */
+    void    *handle;                        /* module handle (dlopen)               */
+    int     (*init)(struct weston_compositor *ec);
+                                            /* enter function of loaded plugin      */
+    int     wd;                             /* inotify watch(reloadable, 0=none)    */
+    int     reload;                         /* file replaced, wait reload           */
+    long long   start;                      /* load start time from loader start(us)*/
+    long long   open_usec;                  /* dlopen(map and relocation) time(us)  */
+    long long   sym_usec;                   /* dlsym time(us)                       */
+    long long   init_usec;                  /* module_init time(us)                 */
+};
+
 /* This function is called from the main body of Weston and initializes this module.*/
 int module_init(struct weston_compositor *ec);
 
 /* Internal function to load one plugin.    */
-static void load_module(struct weston_compositor *ec, const char *path, const char *entry);
+static void load_module(struct weston_compositor *ec, struct plugin_module *module,
+                        const char *entry);
+                                            /* get current time(us)                 */
+static long long loader_usec(void);
+                                            /* read dependency section of module    */
+static int module_depends(const char *path, char *buf, const int size);
+                                            /* add module to load list              */
+static void module_regist(const char *path);
+                                            /* search module by file name           */
+static struct plugin_module *module_find(const char *name, const int len);
+                                            /* check dependency of module           */
+static int module_ready(struct plugin_module *module);
+                                            /* select next module to load           */
+static struct plugin_module *module_next(void);
+                                            /* output load timeline                 */
+static void module_timeline(const long long total);
+                                            /* check whether module depends on name */
+static int module_has_depend(struct plugin_module *module, const char *name);
+                                            /* watch replace of reloadable plugins  */
+static void module_watch(struct weston_compositor *ec);
+                                            /* plugin file replaced(inotify event)  */
+static int module_notify(int fd, uint32_t mask, void *data);
+                                            /* reload replaced plugins(timer)       */
+static int module_reload_timer(void *data);
+                                            /* unload and reload one plugin         */
+static void module_reload(struct plugin_module *module);
 
 /* Static valiables                         */
 static char *moddir = NULL;                 /* Answer back from configuration       */
 static char *modules = NULL;                /* Answer back from configuration       */
-static int  debug_level = 3;                /* Debug Level                          */
+static int  lazy_bind = 1;                  /* Resolve function symbols lazily      */
+static int  reload = 0;                     /* Reload replaced plugins              */
+int         ico_ivi_debug_level = 3;        /* Debug Level(referred by uifw_xxx)    */
+static struct plugin_module module_table[ICO_PLUGIN_MAX_MODULES];
+                                            /* plugin modules in configuration order*/
+static int  num_modules = 0;                /* number of plugin modules             */
+static long long    loader_start = 0;       /* loader start time(us)                */
+static struct weston_compositor *loader_ec = NULL;
+                                            /* Weston compositor                    */
+static int  reload_fd = -1;                 /* inotify of reloadable plugins        */
+static struct wl_event_source *reload_timer = NULL;
+                                            /* reload timer(after file replaced)    */
 
 /* Configuration key                        */
 static const struct config_key plugin_config_keys[] = {
         { "moddir", CONFIG_KEY_STRING, &moddir },
         { "modules", CONFIG_KEY_STRING, &modules },
-    };
-
-static const struct config_section conf_plugin[] = {
-        { "plugin", plugin_config_keys, ARRAY_LENGTH(plugin_config_keys) },
+        { "lazy_bind", CONFIG_KEY_INTEGER, &lazy_bind },
+        { "reload", CONFIG_KEY_INTEGER, &reload },
     };
 
 static const struct config_key debug_config_keys[] = {
-        { "ivi_debug", CONFIG_KEY_INTEGER, &debug_level },
+        { "ivi_debug", CONFIG_KEY_INTEGER, &ico_ivi_debug_level },
     };
 
-static const struct config_section conf_debug[] = {
+static const struct config_section conf_plugin[] = {
+        { "plugin", plugin_config_keys, ARRAY_LENGTH(plugin_config_keys) },
         { "debug", debug_config_keys, ARRAY_LENGTH(debug_config_keys) },
     };
 
@@ -88,65 +159,622 @@ static const struct config_section conf_debug[] = {
 int
 ico_ivi_debuglevel(void)
 {
-    return debug_level;
+    return ico_ivi_debug_level;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   load_module: load one plugin module.
+ * @brief   loader_usec: get current monotonic time.
  *
- * @param[in]   ec          weston compositor. (from weston)
- * @param[in]   path        file path of plugin module.
- * @param[in]   entry       entry function name of plugin module.
+ * @param       none
+ * @return      current time(us)
+ */
+/*--------------------------------------------------------------------------*/
+static long long
+loader_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((long long)ts.tv_sec * 1000000LL) + (long long)(ts.tv_nsec / 1000);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_depends: read dependency list of plugin module from
+ *                          its ELF section(ICO_PLUGIN_DEPENDS_SECTION)
+ *                          without loading the module.
+ *
+ * @param[in]   path        file path of plugin module
+ * @param[out]  buf         dependency list(comma separated file names)
+ * @param[in]   size        size of buf
+ * @return      length of dependency list
+ * @retval      >= 0        success(0 is no dependency declared)
+ * @retval      -1          file can not read
+ */
+/*--------------------------------------------------------------------------*/
+static int
+module_depends(const char *path, char *buf, const int size)
+{
+    int         fd;
+    int         idx;
+    int         len = 0;
+    ElfW(Ehdr)  ehdr;
+    ElfW(Shdr)  *shdr = NULL;
+    char        *strtab = NULL;
+    size_t      strsize;
+
+    buf[0] = 0;
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    if (pread(fd, &ehdr, sizeof(ehdr), 0) != (ssize_t)sizeof(ehdr))    {
+        close(fd);
+        return -1;
+    }
+    if ((memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) ||
+        (ehdr.e_ident[EI_CLASS] != ((sizeof(void *) == 8) ? ELFCLASS64 : ELFCLASS32)) ||
+        (ehdr.e_shentsize != sizeof(ElfW(Shdr))) || (ehdr.e_shnum == 0) ||
+        (ehdr.e_shstrndx >= ehdr.e_shnum))  {
+        /* not a ELF file of this architecture, dlopen will report error    */
+        close(fd);
+        return 0;
+    }
+
+    shdr = malloc(sizeof(ElfW(Shdr)) * ehdr.e_shnum);
+    if (! shdr) {
+        close(fd);
+        return 0;
+    }
+    if (pread(fd, shdr, sizeof(ElfW(Shdr)) * ehdr.e_shnum, ehdr.e_shoff)
+            != (ssize_t)(sizeof(ElfW(Shdr)) * ehdr.e_shnum))   {
+        goto out;
+    }
+
+    /* read section name table                      */
+    strsize = shdr[ehdr.e_shstrndx].sh_size;
+    strtab = malloc(strsize + 1);
+    if ((! strtab) ||
+        (pread(fd, strtab, strsize, shdr[ehdr.e_shstrndx].sh_offset) != (ssize_t)strsize))  {
+        goto out;
+    }
+    strtab[strsize] = 0;
+
+    /* search dependency section                    */
+    for (idx = 0; idx < ehdr.e_shnum; idx++)    {
+        if ((shdr[idx].sh_name < strsize) &&
+            (strcmp(&strtab[shdr[idx].sh_name], ICO_PLUGIN_DEPENDS_SECTION) == 0))  {
+            len = shdr[idx].sh_size;
+            if (len >= size)    {
+                len = size - 1;
+            }
+            if (pread(fd, buf, len, shdr[idx].sh_offset) != (ssize_t)len)  {
+                len = 0;
+            }
+            buf[len] = 0;
+            len = strlen(buf);
+            break;
+        }
+    }
+out:
+    free(strtab);
+    free(shdr);
+    close(fd);
+    return len;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_regist: add plugin module to load list.
+ *
+ * @param[in]   path        file path of plugin module
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 static void
-load_module(struct weston_compositor *ec, const char *path, const char *entry)
+module_regist(const char *path)
 {
-    void    *module;                    /* module informations (dlopen)             */
-    int (*init)(struct weston_compositor *ec);
-                                        /* enter function of loaded plugin          */
-
-    uifw_info("ico_plugin_loader: Load(path=%s entry=%s)", path, entry);
+    struct plugin_module    *module;
+    const char  *name;
 
-    /* get module informations                      */
-    module = dlopen(path, RTLD_NOW | RTLD_NOLOAD);
+    name = strrchr(path, '/');
+    name = name ? (name + 1) : path;
 
-    if (module) {
-        /* plugin module already loaded             */
-        dlclose(module);
-        uifw_error("ico_plugin_loader: Load Error(%s already loaded)", path);
+    if (module_find(name, strlen(name)))    {
+        /* same plugin module listed twice, load only first one */
+        uifw_warn("ico_plugin_loader: %s already listed, ignored", path);
+        return;
+    }
+    if (num_modules >= ICO_PLUGIN_MAX_MODULES)  {
+        uifw_error("ico_plugin_loader: Load Error(%s too many plugins)", path);
         return;
     }
+    module = &module_table[num_modules++];
+    memset(module, 0, sizeof(struct plugin_module));
+    strncpy(module->path, path, ICO_PLUGIN_PATH_LEN-1);
+    strncpy(module->name, name, ICO_PLUGIN_NAME_LEN-1);
+    module->state = ICO_PLUGIN_PENDING;
+
+    if (module_depends(path, module->depends, ICO_PLUGIN_DEPENDS_LEN) > 0)  {
+        uifw_trace("ico_plugin_loader: %s depends on <%s>", module->name, module->depends);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_find: search plugin module by file name.
+ *
+ * @param[in]   name        file name of plugin module(not NULL terminated)
+ * @param[in]   len         length of name
+ * @return      plugin module
+ * @retval      !=NULL      success(plugin module)
+ * @retval      NULL        not listed
+ */
+/*--------------------------------------------------------------------------*/
+static struct plugin_module *
+module_find(const char *name, const int len)
+{
+    int     idx;
+
+    for (idx = 0; idx < num_modules; idx++) {
+        if ((strncmp(module_table[idx].name, name, len) == 0) &&
+            (module_table[idx].name[len] == 0)) {
+            return &module_table[idx];
+        }
+    }
+    return NULL;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_ready: check whether all dependent plugins are loaded.
+ *                        dependent plugin that is not listed in the
+ *                        configuration is error(lazy binding of its symbols
+ *                        would abort weston at first call).
+ *
+ * @param[in]   module      plugin module
+ * @return      result
+ * @retval      1           all dependent plugins are loaded
+ * @retval      0           some dependent plugins are not loaded yet
+ * @retval      -1          some dependent plugins failed to load or not listed
+ */
+/*--------------------------------------------------------------------------*/
+static int
+module_ready(struct plugin_module *module)
+{
+    struct plugin_module    *dep;
+    char    *p;
+    char    *end;
+
+    p = module->depends;
+    while (*p)  {
+        while ((*p == ',') || (*p == ' ')) {
+            p++;
+        }
+        if (*p == 0)    {
+            break;
+        }
+        end = strchrnul(p, ',');
+        dep = module_find(p, (int)(end - p));
+        if (! dep)  {
+            uifw_error("ico_plugin_loader: Load Error(%s, dependent %.*s not listed)",
+                       module->path, (int)(end - p), p);
+            return -1;
+        }
+        if ((dep->state == ICO_PLUGIN_FAILED) || (dep->state == ICO_PLUGIN_SKIPPED))   {
+            uifw_error("ico_plugin_loader: Load Error(%s, dependent %s not loaded)",
+                       module->path, dep->name);
+            return -1;
+        }
+        if (dep->state != ICO_PLUGIN_LOADED)    {
+            return 0;
+        }
+        p = end;
+    }
+    return 1;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_next: select next plugin module to load.
+ *                       first module in configuration order that all dependent
+ *                       plugins are loaded is selected.
+ *
+ * @param       none
+ * @return      plugin module
+ * @retval      !=NULL      success(plugin module to load)
+ * @retval      NULL        all plugin modules are processed
+ */
+/*--------------------------------------------------------------------------*/
+static struct plugin_module *
+module_next(void)
+{
+    struct plugin_module    *first;
+    int     idx;
+    int     ret;
+
+again:
+    first = NULL;
+    for (idx = 0; idx < num_modules; idx++) {
+        if (module_table[idx].state != ICO_PLUGIN_PENDING)  continue;
+        if (! first)    {
+            first = &module_table[idx];
+        }
+        ret = module_ready(&module_table[idx]);
+        if (ret < 0)    {
+            module_table[idx].state = ICO_PLUGIN_SKIPPED;
+            goto again;
+        }
+        if (ret > 0)    {
+            return &module_table[idx];
+        }
+    }
+    if (first)  {
+        /* circular dependency, load in configuration order */
+        uifw_warn("ico_plugin_loader: circular dependency(%s <%s>), load in config order",
+                  first->name, first->depends);
+    }
+    return first;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   load_module: load one plugin module.
+ *
+ * @param[in]   ec          weston compositor. (from weston)
+ * @param[in]   module      plugin module.
+ * @param[in]   entry       entry function name of plugin module.
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+load_module(struct weston_compositor *ec, struct plugin_module *module, const char *entry)
+{
+    long long   t;
+    int         ret;
+
+    uifw_info("ico_plugin_loader: Load(path=%s entry=%s)", module->path, entry);
 
     /* load plugin module                           */
-    uifw_trace("ico_plugin_loader: %s loading", path);
+    uifw_trace("ico_plugin_loader: %s loading", module->path);
 
-    module = dlopen(path, RTLD_NOW | RTLD_GLOBAL);
+    /* function symbols are resolved at first call(all dependent plugins    */
+    /* are already loaded), data symbols are resolved at dlopen             */
+    t = loader_usec();
+    module->start = t - loader_start;
+    module->handle = dlopen(module->path, (lazy_bind ? RTLD_LAZY : RTLD_NOW) | RTLD_GLOBAL);
+    module->open_usec = loader_usec() - t;
 
-    if (! module)   {
+    if (! module->handle)   {
         /* plugin module dose not exist             */
-        uifw_error("ico_plugin_loader: Load Error(%s error<%s>)", path, dlerror());
+        module->state = ICO_PLUGIN_FAILED;
+        uifw_error("ico_plugin_loader: Load Error(%s error<%s>)", module->path, dlerror());
         return;
     }
+    module->state = ICO_PLUGIN_LOADED;
 
     /* find initialize function                     */
     if (entry)  {
-        init = dlsym(module, entry);
-        if (! init) {
+        t = loader_usec();
+        module->init = dlsym(module->handle, entry);
+        module->sym_usec = loader_usec() - t;
+        if (! module->init) {
+            module->state = ICO_PLUGIN_FAILED;
             uifw_error("ico_plugin_loader: Load Error(%s, function %s dose not exist(%s))",
-                       path, entry, dlerror());
+                       module->path, entry, dlerror());
         }
         else    {
             /* call initialize function             */
-            uifw_trace("ico_plugin_loader: Call %s:%s(%08x)", path, entry, (int)init);
-            init(ec);
-            uifw_info("ico_plugin_loader: %s Loaded", path);
+            uifw_trace("ico_plugin_loader: Call %s:%s(%p)",
+                       module->path, entry, (void *)module->init);
+            t = loader_usec();
+            ret = module->init(ec);
+            module->init_usec = loader_usec() - t;
+            if (ret != 0)   {
+                /* initialize error, dependent plugins are skipped  */
+                module->state = ICO_PLUGIN_FAILED;
+                uifw_error("ico_plugin_loader: Load Error(%s, %s error(%d))",
+                           module->path, entry, ret);
+            }
+            else    {
+                uifw_info("ico_plugin_loader: %s Loaded", module->path);
+            }
+        }
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_timeline: output load timeline of plugin modules, and
+ *                           publish it as runtime metrics if ico_ivi_common
+ *                           is loaded.
+ *
+ * @param[in]   total       total load time(us)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+module_timeline(const long long total)
+{
+    struct ico_ivi_metric *(*regist)(const char *name, const int type);
+    struct ico_ivi_metric   *metric;
+    struct plugin_module    *module;
+    static const char   *state_name[] = { "pending", "loaded", "failed", "skipped" };
+    char    name[ICO_IVI_METRIC_NAME_LEN];
+    int     len;
+    int     idx;
+
+    /* ico_ivi_common is loaded by this loader, resolve it at run time  */
+    regist = dlsym(RTLD_DEFAULT, "ico_ivi_metric_regist");
+
+    for (idx = 0; idx < num_modules; idx++) {
+        module = &module_table[idx];
+        uifw_info("ico_plugin_loader: timeline %-24s %-7s start=%lldus dlopen=%lldus "
+                  "dlsym=%lldus init=%lldus", module->name, state_name[module->state],
+                  module->start, module->open_usec, module->sym_usec, module->init_usec);
+        if ((! regist) || (module->state != ICO_PLUGIN_LOADED)) continue;
+
+        len = strlen(module->name);
+        if ((len > 3) && (strcmp(&module->name[len-3], ".so") == 0))   {
+            len -= 3;
         }
+        snprintf(name, sizeof(name), "loader.%.*s.dlopen_usec", len, module->name);
+        metric = regist(name, ICO_IVI_METRIC_GAUGE);
+        ico_ivi_metric_set(metric, (int32_t)module->open_usec);
+        snprintf(name, sizeof(name), "loader.%.*s.init_usec", len, module->name);
+        metric = regist(name, ICO_IVI_METRIC_GAUGE);
+        ico_ivi_metric_set(metric, (int32_t)module->init_usec);
+    }
+    uifw_info("ico_plugin_loader: timeline total %lldus(%d plugins, %s binding)",
+              total, num_modules, lazy_bind ? "lazy" : "immediate");
+    if (regist) {
+        metric = regist("loader.total_usec", ICO_IVI_METRIC_GAUGE);
+        ico_ivi_metric_set(metric, (int32_t)total);
     }
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_has_depend: check whether plugin module depends on the plugin.
+ *
+ * @param[in]   module      plugin module
+ * @param[in]   name        file name of dependent plugin
+ * @return      result
+ * @retval      1           module depends on the plugin
+ * @retval      0           module does not depend on the plugin
+ */
+/*--------------------------------------------------------------------------*/
+static int
+module_has_depend(struct plugin_module *module, const char *name)
+{
+    char    *p;
+    char    *end;
+    int     len = strlen(name);
+
+    p = module->depends;
+    while (*p)  {
+        while ((*p == ',') || (*p == ' ')) {
+            p++;
+        }
+        if (*p == 0)    {
+            break;
+        }
+        end = strchrnul(p, ',');
+        if (((int)(end - p) == len) && (strncmp(p, name, len) == 0))    {
+            return 1;
+        }
+        p = end;
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_watch: watch replace of reloadable plugins.
+ *                        directory of plugin is watched, because plugin file
+ *                        must be replaced by new file(install or mv), rewrite
+ *                        of mapped file crashes weston.
+ *
+ * @param[in]   ec          weston compositor
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+module_watch(struct weston_compositor *ec)
+{
+    struct plugin_module    *module;
+    char    dir[ICO_PLUGIN_PATH_LEN];
+    int     idx;
+
+    for (idx = 0; idx < num_modules; idx++) {
+        module = &module_table[idx];
+        if ((module->state != ICO_PLUGIN_LOADED) ||
+            (! dlsym(module->handle, ICO_PLUGIN_EXIT_ENTRY)))  continue;
+
+        if (reload_fd < 0)  {
+            reload_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if ((reload_fd < 0) ||
+                (! wl_event_loop_add_fd(wl_display_get_event_loop(ec->wl_display),
+                                        reload_fd, WL_EVENT_READABLE, module_notify, NULL))) {
+                uifw_warn("ico_plugin_loader: can not watch plugins, reload disabled");
+                if (reload_fd >= 0) {
+                    close(reload_fd);
+                    reload_fd = -1;
+                }
+                return;
+            }
+        }
+        strncpy(dir, module->path, sizeof(dir) - 1);
+        dir[sizeof(dir) - 1] = 0;
+        if (strrchr(dir, '/') == dir)   {
+            dir[1] = 0;
+        }
+        else if (strrchr(dir, '/')) {
+            *strrchr(dir, '/') = 0;
+        }
+        else    {
+            strcpy(dir, ".");
+        }
+        /* same directory returns same watch        */
+        module->wd = inotify_add_watch(reload_fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (module->wd < 0) {
+            uifw_warn("ico_plugin_loader: can not watch %s", dir);
+            module->wd = 0;
+            continue;
+        }
+        uifw_info("ico_plugin_loader: %s is reloadable", module->path);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_notify: plugin file replaced(inotify event),
+ *                         reload after a while to wait end of installation.
+ *
+ * @param[in]   fd          inotify file descriptor
+ * @param[in]   mask        event mask(unused)
+ * @param[in]   data        user data(unused)
+ * @return      always 0
+ */
+/*--------------------------------------------------------------------------*/
+static int
+module_notify(int fd, uint32_t mask, void *data)
+{
+    char    buf[sizeof(struct inotify_event) + NAME_MAX + 1]
+                __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    struct inotify_event    *event;
+    int     len;
+    int     i;
+    int     idx;
+    int     changed = 0;
+
+    while ((len = read(fd, buf, sizeof(buf))) > 0)  {
+        for (i = 0; i < len; i += sizeof(struct inotify_event) + event->len)  {
+            event = (struct inotify_event *)&buf[i];
+            if (event->len <= 0)    continue;
+            for (idx = 0; idx < num_modules; idx++) {
+                if ((module_table[idx].wd == event->wd) &&
+                    (strcmp(module_table[idx].name, event->name) == 0)) {
+                    module_table[idx].reload = 1;
+                    changed = 1;
+                }
+            }
+        }
+    }
+    if (changed)    {
+        if (! reload_timer) {
+            reload_timer = wl_event_loop_add_timer(
+                                wl_display_get_event_loop(loader_ec->wl_display),
+                                module_reload_timer, NULL);
+        }
+        if (reload_timer)   {
+            wl_event_source_timer_update(reload_timer, ICO_PLUGIN_RELOAD_DELAY);
+        }
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_reload_timer: reload replaced plugins.
+ *
+ * @param[in]   data        user data(unused)
+ * @return      always 0
+ */
+/*--------------------------------------------------------------------------*/
+static int
+module_reload_timer(void *data)
+{
+    int     idx;
+
+    for (idx = 0; idx < num_modules; idx++) {
+        if (module_table[idx].reload)   {
+            module_table[idx].reload = 0;
+            module_reload(&module_table[idx]);
+        }
+    }
+    return 0;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_reload: unload and reload one plugin.
+ *                         plugin releases all references to it by module_exit,
+ *                         and is initialized again by module_init after reload.
+ *                         plugin which other plugins depend on is not reloaded.
+ *
+ * @param[in]   module      plugin module
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+module_reload(struct plugin_module *module)
+{
+    int (*fini)(struct weston_compositor *ec);
+    void (*release)(const void *addr);
+    void    *handle;
+    int     idx;
+
+    uifw_info("ico_plugin_loader: Enter(reload %s)", module->path);
+
+    if (module->state != ICO_PLUGIN_LOADED) {
+        uifw_warn("ico_plugin_loader: Leave(%s not loaded)", module->name);
+        return;
+    }
+    for (idx = 0; idx < num_modules; idx++) {
+        if ((module_table[idx].state == ICO_PLUGIN_LOADED) &&
+            (module_has_depend(&module_table[idx], module->name)))  {
+            uifw_warn("ico_plugin_loader: Leave(%s depends on %s, not reloaded)",
+                      module_table[idx].name, module->name);
+            return;
+        }
+    }
+
+    /* release references to the plugin            */
+    fini = dlsym(module->handle, ICO_PLUGIN_EXIT_ENTRY);
+    if ((! fini) || (fini(loader_ec) != 0)) {
+        uifw_warn("ico_plugin_loader: Leave(%s refused unload)", module->name);
+        return;
+    }
+    release = dlsym(RTLD_DEFAULT, "ico_ivi_watch_release");
+    if (release)    {
+        release((const void *)fini);
+    }
+
+    /* unload plugin                                */
+    dlclose(module->handle);
+    module->handle = NULL;
+    module->init = NULL;
+    handle = dlopen(module->path, RTLD_LAZY | RTLD_NOLOAD);
+    if (handle) {
+        /* still referred by other object, old code will be initialized again   */
+        uifw_warn("ico_plugin_loader: %s still mapped, not replaced", module->name);
+        dlclose(handle);
+    }
+
+    /* load new plugin                              */
+    module->state = ICO_PLUGIN_PENDING;
+    module_depends(module->path, module->depends, ICO_PLUGIN_DEPENDS_LEN);
+    if (module_ready(module) <= 0)  {
+        module->state = ICO_PLUGIN_FAILED;
+        uifw_error("ico_plugin_loader: Leave(%s dependent plugin not loaded)",
+                   module->name);
+        return;
+    }
+    module->open_usec = 0;
+    module->sym_usec = 0;
+    module->init_usec = 0;
+    load_module(loader_ec, module, "module_init");
+
+    if (module->state != ICO_PLUGIN_LOADED) {
+        uifw_error("ico_plugin_loader: Leave(reload %s failed)", module->name);
+        return;
+    }
+    uifw_info("ico_plugin_loader: Leave(reload %s loaded dlopen=%lldus init=%lldus)",
+              module->name, module->open_usec, module->init_usec);
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   module_init: initialize function of ico_plugin_loader
@@ -164,14 +792,18 @@ module_init(struct weston_compositor *ec)
     int     config_fd;
     char    *p;
     char    *end;
-    char    buffer[256];
+    char    buffer[ICO_PLUGIN_PATH_LEN];
+    struct plugin_module    *module;
 
     uifw_info("ico_plugin_loader: Enter(module_init)");
 
-    /* get plugin module name from config file(weston_ivi_plugin.ini)   */
+    loader_start = loader_usec();
+    loader_ec = ec;
+
+    /* get plugin module name and debug level from config file(weston_ivi_plugin.ini)*/
+    /* at one pass, ico_ivi_common is not loaded yet, can not use its cache        */
     config_fd = open_config_file(ICO_IVI_PLUGIN_CONFIG);
     parse_config_file(config_fd, conf_plugin, ARRAY_LENGTH(conf_plugin), NULL);
-    parse_config_file(config_fd, conf_debug, ARRAY_LENGTH(conf_debug), NULL);
     close(config_fd);
 
     if (modules == NULL)    {
@@ -180,6 +812,7 @@ module_init(struct weston_compositor *ec)
     }
     moddir = getenv("WESTON_IVI_PLUGIN_DIR");
 
+    /* make load list and read dependency of each plugin    */
     p = modules;
     while (*p) {
         end = strchrnul(p, ',');
@@ -192,13 +825,24 @@ module_init(struct weston_compositor *ec)
         else    {
             snprintf(buffer, sizeof(buffer), "%s/%.*s", MODULEDIR, (int) (end - p), p);
         }
-        load_module(ec, buffer, "module_init");
+        module_regist(buffer);
         p = end;
         while (*p == ',')   {
             p++;
         }
     }
 
+    /* load plugins in order of dependency          */
+    while ((module = module_next()) != NULL)    {
+        load_module(ec, module, "module_init");
+    }
+
+    module_timeline(loader_usec() - loader_start);
+
+    if (reload) {
+        module_watch(ec);
+    }
+
     uifw_info("ico_plugin_loader: Leave(module_init)");
 
     return 0;
@@ -0,0 +1,207 @@
+/*
+ * Copyright © 2010-2011 Intel Corporation
+ * Copyright © 2008-2011 Kristian Høgsberg
+ * Copyright © 2013 TOYOTA MOTOR CORPORATION.
+ *
+ * Permission to use, copy, modify, distribute, and sell this software and
+ * its documentation for any purpose is hereby granted without fee, provided
+ * that the above copyright notice appear in all copies and that both that
+ * copyright notice and this permission notice appear in supporting
+ * documentation, and that the name of the copyright holders not be used in
+ * advertising or publicity pertaining to distribution of the software
+ * without specific, written prior permission.  The copyright holders make
+ * no representations about the suitability of this software for any
+ * purpose.  It is provided "as is" without express or implied warranty.
+ *
+ * THE COPYRIGHT HOLDERS DISCLAIM ALL WARRANTIES WITH REGARD TO THIS
+ * SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS, IN NO EVENT SHALL THE COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * SPECIAL, INDIRECT OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER
+ * RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF
+ * CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+ * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+/**
+ * @brief   Offline decoder of binary trace ring buffer file
+ *          (written by ico_ivi_common with [debug] trace_file)
+ *
+ * @date    Oct-18-2026
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "ico_ivi_trace.h"
+
+/* Tracepoint table                     */
+struct trace_point {
+    const char  *name;                      /* tracepoint name                      */
+    const char  *format;                    /* format of arguments                  */
+};
+
+#define ICO_TRACE_TABLE(id, name, format)   { name, format },
+static const struct trace_point trace_points[] = {
+    ICO_TRACE_POINTS(ICO_TRACE_TABLE)
+};
+#undef ICO_TRACE_TABLE
+
+/* prototype of static function */
+static void print_record(const struct ico_trace_record *rec, const uint64_t basetime,
+                         const uint64_t prevtime);
+static void usage(const char *prog);
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   print_record: print one trace record as text
+ *
+ * @param[in]   rec         trace record
+ * @param[in]   basetime    trace start time(usec)
+ * @param[in]   prevtime    time of previous record(usec, 0=first record)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+print_record(const struct ico_trace_record *rec, const uint64_t basetime,
+             const uint64_t prevtime)
+{
+    int32_t     arg[ICO_TRACE_MAXARGS];
+    uint64_t    elapse;
+    int         i;
+
+    memset(arg, 0, sizeof(arg));
+    for (i = 0; (i < rec->nargs) && (i < ICO_TRACE_MAXARGS); i++)   {
+        arg[i] = rec->arg[i];
+    }
+    elapse = rec->time - basetime;
+    printf("%6d.%06d (+%6d) %8u ", (int)(elapse / 1000000), (int)(elapse % 1000000),
+           prevtime ? (int)(rec->time - prevtime) : 0, rec->seq - 1);
+
+    if (rec->id < ICO_TP_MAX)   {
+        printf("%s: ", trace_points[rec->id].name);
+        printf(trace_points[rec->id].format,
+               arg[0], arg[1], arg[2], arg[3], arg[4], arg[5]);
+    }
+    else    {
+        printf("unknown(%d):", rec->id);
+        for (i = 0; i < rec->nargs; i++)    {
+            printf(" %08x", arg[i]);
+        }
+    }
+    printf("\n");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   usage: print usage
+ *
+ * @param[in]   prog        program name
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-n records] trace_file\n", prog);
+    fprintf(stderr, "  -n records  print only last records\n");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   main: decode binary trace ring buffer file
+ *
+ * @param[in]   argc        number of arguments
+ * @param[in]   argv        arguments
+ * @return      result
+ * @retval      0           success
+ * @retval      1           error
+ */
+/*--------------------------------------------------------------------------*/
+int
+main(int argc, char *argv[])
+{
+    int         fd;
+    int         opt;
+    int         last = 0;
+    struct stat st;
+    void        *map;
+    const struct ico_trace_header *hdr;
+    const struct ico_trace_record *rec;
+    uint32_t    head;
+    uint32_t    seq;
+    uint32_t    start;
+    uint64_t    prevtime = 0;
+    int         skip = 0;
+
+    while ((opt = getopt(argc, argv, "n:h")) != -1) {
+        switch (opt)    {
+        case 'n':
+            last = strtol(optarg, (char **)0, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    fd = open(argv[optind], O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &st) < 0))   {
+        fprintf(stderr, "%s: can not open %s\n", argv[0], argv[optind]);
+        return 1;
+    }
+    if ((size_t)st.st_size < sizeof(struct ico_trace_header))  {
+        fprintf(stderr, "%s: %s is not trace file\n", argv[0], argv[optind]);
+        close(fd);
+        return 1;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)  {
+        fprintf(stderr, "%s: can not map %s\n", argv[0], argv[optind]);
+        return 1;
+    }
+
+    hdr = (const struct ico_trace_header *)map;
+    if ((hdr->magic != ICO_TRACE_MAGIC) || (hdr->version != ICO_TRACE_VERSION) ||
+        (hdr->recsize != sizeof(struct ico_trace_record)) ||
+        (hdr->nrecord == 0) || ((hdr->nrecord & (hdr->nrecord - 1)) != 0) ||
+        ((uint64_t)st.st_size < (hdr->hdrsize + (uint64_t)hdr->recsize * hdr->nrecord)))  {
+        fprintf(stderr, "%s: %s is not trace file version %d\n",
+                argv[0], argv[optind], ICO_TRACE_VERSION);
+        munmap(map, st.st_size);
+        return 1;
+    }
+    rec = (const struct ico_trace_record *)((const char *)map + hdr->hdrsize);
+
+    /* oldest record still in the ring      */
+    head = hdr->head;
+    start = (head > hdr->nrecord) ? (head - hdr->nrecord) : 0;
+    if ((last > 0) && ((head - start) > (uint32_t)last))    {
+        start = head - last;
+    }
+    printf("# %u records written, %u records in ring\n", head, head - start);
+
+    for (seq = start; seq != head; seq++)   {
+        if (rec[seq & (hdr->nrecord - 1)].seq != (seq + 1)) {
+            /* record in writing or overwritten */
+            skip ++;
+            continue;
+        }
+        print_record(&rec[seq & (hdr->nrecord - 1)], hdr->basetime, prevtime);
+        prevtime = rec[seq & (hdr->nrecord - 1)].time;
+    }
+    if (skip > 0)   {
+        printf("# %d records skipped(in writing)\n", skip);
+    }
+    munmap(map, st.st_size);
+    return 0;
+}
@@ -43,6 +43,9 @@
 #include "ico_ivi_shell.h"
 #include "ico_window_mgr.h"
 
+/* Plugins that must be loaded before this plugin    */
+ICO_PLUGIN_DEPENDS("ico_ivi_common.so,ico_ivi_shell.so,ico_window_mgr.so");
+
 /* Animation type               */
 #define ANIMA_ZOOM              1           /* ZoomIn/ZoomOut                       */
 #define ANIMA_FADE              2           /* FadeIn/FadeOut                       */
@@ -51,11 +54,25 @@
 #define ANIMA_SLIDE_TOBOTTOM    5           /* SlideIn top to bottom/SlideOut bottom to top*/
 #define ANIMA_SLIDE_TOTOP       6           /* SlideIn bottom to top/SlideOut top to bottom*/
 
+/* animation data pool(default) */
+#define ANIMA_POOL_INITIAL      50          /* number of initial animation data     */
+#define ANIMA_POOL_CHUNK        16          /* number of animation data per growth  */
+#define ANIMA_POOL_MAX          0           /* maximum pool size(0=unlimited)       */
+
 /* Visible control at end of animation  */
 #define ANIMA_NOCONTROL_AT_END  0           /* no need surface show/hide at end of animation*/
 #define ANIMA_SHOW_AT_END       1           /* surface show at end of animation     */
 #define ANIMA_HIDE_AT_END       2           /* surface hide at end of animation     */
 
+/* animation type table(registered to ico_window_mgr) */
+struct animation_type   {
+    struct uifw_animation_ops   ops;        /* animation operation(must be first)   */
+    const char  *name;                      /* animation name                       */
+    int     kind;                           /* animation kind(ANIMA_xxx)            */
+    void    (*step)(struct uifw_win_surface *usurf, const int par);
+                                            /* set surface at current percentage    */
+};
+
 /* animation data               */
 struct animation_data   {
     struct animation_data   *next_free;     /* free data list                       */
@@ -65,20 +82,73 @@ struct animation_data   {
     int     height;                         /* original height                      */
     char    geometry_saved;                 /* need geometry restor at end          */
     char    transform_set;                  /* need transform reset at end          */
-    char    res[2];                         /* (unused)                             */
+    char    pooled;                         /* pooled data(1)/fallback malloc(0)    */
+    char    blend;                          /* blend from retarget point            */
+    short   from_par;                       /* percentage at retarget point         */
+    short   res;                            /* (unused)                             */
+    int     from_x;                         /* X coordinate at retarget point       */
+    int     from_y;                         /* Y coordinate at retarget point       */
+    float   from_alpha;                     /* alpha at retarget point              */
     struct weston_transform transform;      /* transform matrix                     */
     void    (*end_function)(struct weston_animation *animation);
                                             /* animation end function               */
 };
 
+/* animation data chunk(unit of pool growth)    */
+struct animation_chunk  {
+    struct animation_chunk  *next;          /* next chunk                           */
+    struct animation_data   data[];         /* animation datas                      */
+};
+
 /* static valiables             */
 static struct weston_compositor *weston_ec; /* Weston compositor                    */
 static char *default_animation;             /* default animation name               */
 static int  animation_time;                 /* animation time(ms)                   */
 static int  animation_fpar;                 /* animation frame parcent(%)           */
 static struct animation_data    *free_data; /* free data list                       */
+static struct animation_chunk   *chunks;    /* allocated chunks(released at unload) */
+static struct ico_ivi_metric    *m_skip;    /* metric: skipped animation frames     */
+
+/* animation data pool          */
+static struct   {
+    int     chunk;                          /* number of animation data per growth  */
+    int     max;                            /* maximum pool size(0=unlimited)       */
+    int     size;                           /* current pool size                    */
+    int     live;                           /* number of animation data in use      */
+    int     peak;                           /* peak number of animation data in use */
+    int     fallback;                       /* number of fallback allocations       */
+    int     failed;                         /* number of allocation failures        */
+}   pool;
 
 /* static function              */
+                                            /* start animation                      */
+static int animation_start(struct uifw_win_surface *usurf, const int op);
+                                            /* terminate animation(surface destroy) */
+static void animation_destroy(struct uifw_win_surface *usurf);
+                                            /* cancel animation                     */
+static void animation_cancel(struct uifw_win_surface *usurf);
+                                            /* start layer animation                */
+static int animation_start_layer(struct uifw_layer_animation *layer_animation);
+                                            /* layer animation                      */
+static void animation_layer(struct weston_animation *animation,
+                            struct weston_output *output, uint32_t msecs);
+                                            /* retarget running animation           */
+static void animation_retarget(struct uifw_win_surface *usurf, const int from_par);
+                                            /* blend from retarget point            */
+static int animation_blend(const int from, const int to,
+                           const int from_par, const int par);
+                                            /* slide position at percentage         */
+static void animation_slide_position(struct uifw_win_surface *usurf, const int par,
+                                     int *x, int *y);
+                                            /* slide animation step                 */
+static void animation_slide_step(struct uifw_win_surface *usurf, const int par);
+                                            /* fade animation step                  */
+static void animation_fade_step(struct uifw_win_surface *usurf, const int par);
+                                            /* current time(ms)                     */
+static uint32_t animation_now(void);
+                                            /* current percentage of animation      */
+static int animation_par(const uint32_t starttime, const int time,
+                         struct weston_output *output, uint32_t msecs);
                                             /* slide animation                      */
 static void animation_slide(struct weston_animation *animation,
                             struct weston_output *output, uint32_t msecs);
@@ -92,13 +162,86 @@ static int animation_cont(struct weston_animation *animation,
                           struct weston_output *output, uint32_t msecs);
                                             /* terminate animation                  */
 static void animation_end(struct uifw_win_surface *usurf, const int disp);
+                                            /* grow animation data pool             */
+static int animation_pool_grow(const int num);
+                                            /* allocate animation data              */
+static struct animation_data *animation_data_alloc(void);
+                                            /* release animation data               */
+static void animation_data_free(struct animation_data *animadata);
+                                            /* configuration changed                */
+static void animation_reload(void *data);
+
+/* This function is called from the ico_plugin_loader and initializes this module.*/
+int module_init(struct weston_compositor *ec);
+/* This function is called from the ico_plugin_loader before unload this module. */
+int module_exit(struct weston_compositor *ec);
+
+/* animation types              */
+static const struct animation_type  animation_types[] = {
+    { { animation_start, animation_fade, animation_destroy, animation_cancel,
+        animation_start_layer }, "fade", ANIMA_FADE, animation_fade_step },
+    { { animation_start, animation_slide, animation_destroy, animation_cancel,
+        animation_start_layer }, "slide.toright", ANIMA_SLIDE_TORIGHT, animation_slide_step },
+    { { animation_start, animation_slide, animation_destroy, animation_cancel,
+        animation_start_layer }, "slide.toleft", ANIMA_SLIDE_TOLEFT, animation_slide_step },
+    { { animation_start, animation_slide, animation_destroy, animation_cancel,
+        animation_start_layer }, "slide.tobottom", ANIMA_SLIDE_TOBOTTOM, animation_slide_step },
+    { { animation_start, animation_slide, animation_destroy, animation_cancel,
+        animation_start_layer }, "slide.totop", ANIMA_SLIDE_TOTOP, animation_slide_step }
+};
+#define ANIMATION_TYPES (sizeof(animation_types)/sizeof(animation_types[0]))
+
+/* animation type of surface    */
+#define ANIMATION_TYPE(usurf)   \
+    container_of((usurf)->animation.ops, struct animation_type, ops)
+/* animation kind of surface    */
+#define ANIMATION_KIND(usurf)   (ANIMATION_TYPE(usurf)->kind)
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_destroy: terminate animation at surface destroy
+ *
+ * @param[in]   usurf   UIFW surface
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_destroy(struct uifw_win_surface *usurf)
+{
+    if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
+        (usurf->animadata != NULL)) {
+        uifw_trace("animation_destroy: Destroy %08x", (int)usurf);
+        animation_end(usurf, 0);
+    }
+}
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_window_animation: Animation addin entry
+ * @brief   animation_cancel: cancel animation
  *
- * @param[in]   op      animation operation
- * @param[in]   data    data
+ * @param[in]   usurf   UIFW surface
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_cancel(struct uifw_win_surface *usurf)
+{
+    if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) &&
+        (usurf->animation.animation.frame != NULL)) {
+        uifw_trace("animation_cancel: cancel %s.%08x",
+                   usurf->uclient->appid, usurf->id);
+        (*usurf->animation.animation.frame)(&usurf->animation.animation, NULL, 0);
+    }
+    animation_end(usurf, 1);
+    weston_compositor_schedule_repaint(weston_ec);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_start: start show(in)/hide(out) animation
+ *
+ * @param[in]   usurf   UIFW surface(animation.ops already set)
+ * @param[in]   op      animation operation(OPIN/OPOUT)
  * @return      result
  * @retval      ICO_WINDOW_MGR_ANIMATION_RET_ANIMA      success
  * @retval      ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW  success(force visible)
@@ -106,134 +249,102 @@ static void animation_end(struct uifw_win_surface *usurf, const int disp);
  */
 /*--------------------------------------------------------------------------*/
 static int
-ico_window_animation(const int op, void *data)
+animation_start(struct uifw_win_surface *usurf, const int op)
 {
-    struct uifw_win_surface *usurf;
     struct weston_output *output;
     int         ret;
     uint32_t    nowsec;
     struct timeval  nowtv;
     int         time;
+    int         kind;
+    struct animation_data   *animadata;
+    uifw_watch("animation.start", usurf, op);
 
-    if (op == ICO_WINDOW_MGR_ANIMATION_TYPE)    {
-        /* convert animation name to animation type value   */
-        if (strcasecmp((char *)data, "fade") == 0)  {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_FADE);
-            return ANIMA_FADE;
+    kind = ANIMATION_KIND(usurf);
+    animadata = (struct animation_data *)usurf->animadata;
+
+    if ((op == ICO_WINDOW_MGR_ANIMATION_OPMOVE) ||
+        (op == ICO_WINDOW_MGR_ANIMATION_OPRESIZE))  {
+        /* new geometry while slide, move to new geometry from current position */
+        if ((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
+            (! animadata) || (kind == ANIMA_FADE))  {
+            return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
         }
-        else if (strcasecmp((char *)data, "zoom") == 0) {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_ZOOM);
-            return ANIMA_ZOOM;
+        uifw_trace("animation_start: retarget %s.%08x to %d/%d(%d%%)",
+                   usurf->uclient->appid, usurf->id, usurf->x, usurf->y,
+                   usurf->animation.current);
+        animadata->x = usurf->x;
+        animadata->y = usurf->y;
+        animadata->width = usurf->width;
+        animadata->height = usurf->height;
+        usurf->x = usurf->surface->geometry.x;
+        usurf->y = usurf->surface->geometry.y;
+        animation_retarget(usurf, usurf->animation.current);
+        weston_compositor_schedule_repaint(weston_ec);
+        return ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
+    }
+
+    /* setup animation              */
+    if ((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
+        (usurf->animation.current > 95))    {
+        if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) && (animadata)) {
+            /* restart from current position, not from start point */
+            animation_retarget(usurf, 0);
         }
-        else if (strcasecmp((char *)data, "slide.toleft") == 0) {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_SLIDE_TOLEFT);
-            return ANIMA_SLIDE_TOLEFT;
+        usurf->animation.animation.frame_counter = 1;
+        usurf->animation.current = 0;
+        if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_NONE)  {
+            wl_list_init(&usurf->animation.animation.link);
+            output = container_of(weston_ec->output_list.next,
+                                  struct weston_output, link);
+            wl_list_insert(output->animation_list.prev,
+                           &usurf->animation.animation.link);
         }
-        else if (strcasecmp((char *)data, "slide.toright") == 0)    {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_SLIDE_TORIGHT);
-            return ANIMA_SLIDE_TORIGHT;
+    }
+    else if (((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN) &&
+              (op == ICO_WINDOW_MGR_ANIMATION_OPOUT)) ||
+             ((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_OUT) &&
+              (op == ICO_WINDOW_MGR_ANIMATION_OPIN)))   {
+        gettimeofday(&nowtv, NULL);
+        nowsec = (uint32_t)(((long long)nowtv.tv_sec) * 1000L +
+                            ((long long)nowtv.tv_usec) / 1000L);
+        usurf->animation.current = 100 - usurf->animation.current;
+        time = (usurf->animation.time > 0) ? usurf->animation.time : animation_time;
+        ret = ((usurf->animation.current) * time) / 100;
+        if (nowsec >= (uint32_t)ret)    {
+            usurf->animation.starttime = nowsec - ret;
         }
-        else if (strcasecmp((char *)data, "slide.totop") == 0)  {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_SLIDE_TOTOP);
-            return ANIMA_SLIDE_TOTOP;
+        else    {
+            usurf->animation.starttime = ((long long)nowsec) + ((long long)0x100000000L)
+                                         - ((long long)ret);
         }
-        else if (strcasecmp((char *)data, "slide.tobottom") == 0)   {
-            uifw_trace("ico_window_animation: Type %s=>%d", (char *)data, ANIMA_SLIDE_TOBOTTOM);
-            return ANIMA_SLIDE_TOBOTTOM;
+        usurf->animation.animation.frame_counter = 2;
+        if (animadata)  {
+            /* reverse from current position, not mirrored position    */
+            animation_retarget(usurf, usurf->animation.current);
         }
-        uifw_warn("ico_window_animation: Unknown Type %s", (char *)data);
-        return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
     }
 
-    usurf = (struct uifw_win_surface *)data;
-
-    if (op == ICO_WINDOW_MGR_ANIMATION_DESTROY) {
-        if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
-            (usurf->animadata != NULL)) {
-            uifw_trace("ico_window_animation: Destroy %08x", (int)usurf);
-            animation_end(usurf, 0);
-        }
-        return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
-    }
-    if (op == ICO_WINDOW_MGR_ANIMATION_OPCANCEL)    {
-        /* cancel animation                     */
-        if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) &&
-            (usurf->animation.animation.frame != NULL)) {
-            uifw_trace("ico_window_animation: cancel %s.%08x",
-                       usurf->uclient->appid, usurf->id);
-            (*usurf->animation.animation.frame)(&usurf->animation.animation, NULL, 0);
-        }
-        animation_end(usurf, 1);
+    /* set animation function       */
+    if (op == ICO_WINDOW_MGR_ANIMATION_OPIN)    {
+        usurf->animation.state = ICO_WINDOW_MGR_ANIMATION_STATE_IN;
+        uifw_trace("animation_start: show(in) %s.%08x",
+                   usurf->uclient->appid, usurf->id);
         ret = ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
     }
     else    {
-        /* setup animation              */
-        if ((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
-            (usurf->animation.current > 95))    {
-            usurf->animation.animation.frame_counter = 1;
-            usurf->animation.current = 0;
-            if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_NONE)  {
-                wl_list_init(&usurf->animation.animation.link);
-                output = container_of(weston_ec->output_list.next,
-                                      struct weston_output, link);
-                wl_list_insert(output->animation_list.prev,
-                               &usurf->animation.animation.link);
-            }
-        }
-        else if (((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN) &&
-                  (op == ICO_WINDOW_MGR_ANIMATION_OPOUT)) ||
-                 ((usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_OUT) &&
-                  (op == ICO_WINDOW_MGR_ANIMATION_OPIN)))   {
-            gettimeofday(&nowtv, NULL);
-            nowsec = (uint32_t)(((long long)nowtv.tv_sec) * 1000L +
-                                ((long long)nowtv.tv_usec) / 1000L);
-            usurf->animation.current = 100 - usurf->animation.current;
-            time = (usurf->animation.time > 0) ? usurf->animation.time : animation_time;
-            ret = ((usurf->animation.current) * time) / 100;
-            if (nowsec >= (uint32_t)ret)    {
-                usurf->animation.starttime = nowsec - ret;
-            }
-            else    {
-                usurf->animation.starttime = ((long long)nowsec) + ((long long)0x100000000L)
-                                             - ((long long)ret);
-            }
-            usurf->animation.animation.frame_counter = 2;
-        }
-
-        /* set animation function       */
-        if (op == ICO_WINDOW_MGR_ANIMATION_OPIN)    {
-            usurf->animation.state = ICO_WINDOW_MGR_ANIMATION_STATE_IN;
-            uifw_trace("ico_window_animation: show(in) %s.%08x",
-                       usurf->uclient->appid, usurf->id);
-            ret = ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
-        }
-        else    {
-            usurf->animation.state = ICO_WINDOW_MGR_ANIMATION_STATE_OUT;
-            uifw_trace("ico_window_animation: hide(out) %s.%08x",
-                       usurf->uclient->appid, usurf->id);
-            ret = ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW;
-        }
-        if ((usurf->animation.type == ANIMA_SLIDE_TOLEFT) ||
-            (usurf->animation.type == ANIMA_SLIDE_TORIGHT) ||
-            (usurf->animation.type == ANIMA_SLIDE_TOTOP) ||
-            (usurf->animation.type == ANIMA_SLIDE_TOBOTTOM))    {
-            usurf->animation.animation.frame = animation_slide;
-            ivi_shell_restrain_configure(usurf->shsurf, 1);
-            (*usurf->animation.animation.frame)(&usurf->animation.animation, NULL, 1);
-        }
-        else if (usurf->animation.type == ANIMA_FADE)   {
-            usurf->animation.animation.frame = animation_fade;
-            (*usurf->animation.animation.frame)(&usurf->animation.animation, NULL, 1);
-        }
-        else    {
-            /* no yet support   */
-            usurf->animation.animation.frame = NULL;
-            usurf->animation.state = ICO_WINDOW_MGR_ANIMATION_STATE_NONE;
-            ivi_shell_restrain_configure(usurf->shsurf, 0);
-            wl_list_remove(&usurf->animation.animation.link);
-            ret = ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
-        }
+        usurf->animation.state = ICO_WINDOW_MGR_ANIMATION_STATE_OUT;
+        uifw_trace("animation_start: hide(out) %s.%08x",
+                   usurf->uclient->appid, usurf->id);
+        ret = ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW;
     }
+    usurf->animation.animation.frame = usurf->animation.ops->frame;
+    if ((kind == ANIMA_SLIDE_TOLEFT) || (kind == ANIMA_SLIDE_TORIGHT) ||
+        (kind == ANIMA_SLIDE_TOTOP) || (kind == ANIMA_SLIDE_TOBOTTOM))  {
+        ico_window_mgr_restrain_configure(usurf, 1);
+    }
+    (*usurf->animation.animation.frame)(&usurf->animation.animation, NULL, 1);
+
     if (ret == ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW)  {
         usurf->animation.visible = ANIMA_HIDE_AT_END;
     }
@@ -244,6 +355,266 @@ ico_window_animation(const int op, void *data)
     return ret;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_start_layer: start layer animation,
+ *                                 all surfaces in the layer share one timeline
+ *
+ * @param[in]   layer_animation layer animation(surfaces are set by window manager)
+ * @return      result
+ * @retval      ICO_WINDOW_MGR_ANIMATION_RET_ANIMA      success
+ * @retval      ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA    error(no animation)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+animation_start_layer(struct uifw_layer_animation *layer_animation)
+{
+    struct uifw_win_surface *usurf;
+    struct animation_data   *animadata;
+    struct weston_output    *output;
+    int     kind;
+    int     num = 0;
+    int     time;
+    int     i;
+    uifw_watch("animation.start_layer", layer_animation, 0);
+
+    uifw_trace("animation_start_layer: Enter(layer=%d, %s, %d surfaces)",
+               layer_animation->layer,
+               layer_animation->state == ICO_WINDOW_MGR_ANIMATION_STATE_IN ? "in" : "out",
+               layer_animation->num_surface);
+
+    if (layer_animation->animation.frame != NULL)   {
+        /* running, reverse from current state of each surface  */
+        layer_animation->current = 100 - layer_animation->current;
+        time = (layer_animation->time > 0) ? layer_animation->time : animation_time;
+        layer_animation->starttime = animation_now() -
+                                     (uint32_t)((layer_animation->current * time) / 100);
+        for (i = 0; i < layer_animation->num_surface; i++)  {
+            usurf = layer_animation->usurf[i];
+            if ((! usurf) || (! usurf->animadata))  continue;
+            usurf->animation.state = layer_animation->state;
+            animation_retarget(usurf, layer_animation->current);
+        }
+        weston_compositor_schedule_repaint(weston_ec);
+        uifw_trace("animation_start_layer: Leave(reverse at %d%%)", layer_animation->current);
+        return ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
+    }
+
+    for (i = 0; i < layer_animation->num_surface; i++)  {
+        usurf = layer_animation->usurf[i];
+        if (! usurf)    continue;
+
+        animadata = animation_data_alloc();
+        if (! animadata)    {
+            /* no memory, this surface changes without animation    */
+            layer_animation->usurf[i] = NULL;
+            usurf->layer_animation = NULL;
+            continue;
+        }
+        animadata->x = usurf->x;
+        animadata->y = usurf->y;
+        animadata->width = usurf->width;
+        animadata->height = usurf->height;
+        animadata->geometry_saved = 1;
+        usurf->animadata = (void *)animadata;
+
+        /* surface is driven by layer animation, not by own frame   */
+        wl_list_init(&usurf->animation.animation.link);
+        usurf->animation.animation.frame = usurf->animation.ops->frame;
+        usurf->animation.animation.frame_counter = 2;
+        usurf->animation.state = layer_animation->state;
+        usurf->animation.visible = ANIMA_NOCONTROL_AT_END;
+        usurf->animation.current = 0;
+        usurf->animation.starttime = animation_now();
+
+        kind = ANIMATION_KIND(usurf);
+        if ((kind == ANIMA_SLIDE_TOLEFT) || (kind == ANIMA_SLIDE_TORIGHT) ||
+            (kind == ANIMA_SLIDE_TOTOP) || (kind == ANIMA_SLIDE_TOBOTTOM))  {
+            ico_window_mgr_restrain_configure(usurf, 1);
+        }
+        num ++;
+    }
+    if (num <= 0)   {
+        uifw_trace("animation_start_layer: Leave(no surface)");
+        return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
+    }
+
+    layer_animation->current = 0;
+    layer_animation->starttime = animation_now();
+    layer_animation->animation.frame_counter = 1;
+    layer_animation->animation.frame = animation_layer;
+    wl_list_init(&layer_animation->animation.link);
+    output = container_of(weston_ec->output_list.next, struct weston_output, link);
+    wl_list_insert(output->animation_list.prev, &layer_animation->animation.link);
+
+    /* set first position before first repaint  */
+    animation_layer(&layer_animation->animation, output, 1);
+
+    uifw_trace("animation_start_layer: Leave(%d surfaces)", num);
+    return ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_layer: layer animation frame
+ *
+ * @param[in]   animation   weston animation table(in layer animation)
+ * @param[in]   output      weston output table
+ * @param[in]   msecs       current time stamp
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_layer(struct weston_animation *animation,
+                struct weston_output *output, uint32_t msecs)
+{
+    struct uifw_layer_animation *layer_animation;
+    struct uifw_win_surface *usurf;
+    struct animation_data   *animadata;
+    int     par;
+    int     i;
+
+    layer_animation = container_of(animation, struct uifw_layer_animation, animation);
+
+    /* one timeline for all surfaces in the layer   */
+    par = animation_par(layer_animation->starttime, layer_animation->time, output, msecs);
+    if ((par < 100) && (layer_animation->animation.frame_counter > 1) &&
+        (abs(layer_animation->current - par) < animation_fpar))  {
+        weston_compositor_schedule_repaint(weston_ec);
+        return;
+    }
+    layer_animation->current = par;
+    layer_animation->animation.frame_counter ++;
+
+    uifw_trace("animation_layer: layer=%d %d%%", layer_animation->layer, par);
+
+    for (i = 0; i < layer_animation->num_surface; i++)  {
+        usurf = layer_animation->usurf[i];
+        if ((! usurf) || (! usurf->animadata))  continue;
+        usurf->animation.current = par;
+        (*ANIMATION_TYPE(usurf)->step)(usurf, par);
+    }
+    if (par < 100)  {
+        /* continue animation   */
+        weston_compositor_schedule_repaint(weston_ec);
+        return;
+    }
+
+    /* end of animation, restore surfaces and change layer visibility   */
+    wl_list_remove(&layer_animation->animation.link);
+    for (i = 0; i < layer_animation->num_surface; i++)  {
+        usurf = layer_animation->usurf[i];
+        if (! usurf)    continue;
+        animadata = (struct animation_data *)usurf->animadata;
+        if (animadata)  {
+            animadata->geometry_saved ++;   /* restore geometry     */
+        }
+        animation_end(usurf, 1);
+    }
+    uifw_trace("animation_layer: End of layer %d animation", layer_animation->layer);
+    (*layer_animation->end)(layer_animation);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_retarget: save current state of surface as retarget point,
+ *                              animation continues from this point to new target
+ *
+ * @param[in]   usurf       UIFW surface table
+ * @param[in]   from_par    percentage at retarget point
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_retarget(struct uifw_win_surface *usurf, const int from_par)
+{
+    struct animation_data   *animadata = (struct animation_data *)usurf->animadata;
+
+    animadata->blend = 1;
+    animadata->from_par = (from_par < 100) ? from_par : 99;
+    animadata->from_x = usurf->x;
+    animadata->from_y = usurf->y;
+    animadata->from_alpha = usurf->surface->alpha;
+    uifw_trace("animation_retarget: usurf=%08x from %d/%d/%d%%(alpha=%d%%)",
+               (int)usurf, animadata->from_x, animadata->from_y,
+               animadata->from_par, (int)(animadata->from_alpha * 100.0));
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_blend: value between retarget point and target
+ *
+ * @param[in]   from        value at retarget point
+ * @param[in]   to          target value(value at 100%)
+ * @param[in]   from_par    percentage at retarget point
+ * @param[in]   par         current percentage
+ * @return      current value
+ */
+/*--------------------------------------------------------------------------*/
+static int
+animation_blend(const int from, const int to, const int from_par, const int par)
+{
+    if (par >= 100)         return to;
+    if (par <= from_par)    return from;
+    return from + (to - from) * (par - from_par) / (100 - from_par);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_now: current time
+ *
+ * @param       none
+ * @return      current time(ms)
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+animation_now(void)
+{
+    struct timeval  nowtv;
+
+    gettimeofday(&nowtv, NULL);
+    return (uint32_t)(((long long)nowtv.tv_sec) * 1000L +
+                      ((long long)nowtv.tv_usec) / 1000L);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_par: current percentage of animation
+ *
+ * @param[in]   starttime   animation start time(ms)
+ * @param[in]   time        animation time(ms), if 0, default time
+ * @param[in]   output      weston output table(if NULL and msecs=0, end of animation)
+ * @param[in]   msecs       current time stamp
+ * @return      current percentage(2-100)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+animation_par(const uint32_t starttime, const int time,
+              struct weston_output *output, uint32_t msecs)
+{
+    uint32_t    nowsec;
+    int         atime;
+    int         par;
+
+    nowsec = animation_now();
+    if (nowsec >= starttime)    {
+        nowsec = nowsec - starttime;        /* elapsed time(ms) */
+    }
+    else    {
+        nowsec = (uint32_t)(((long long)0x100000000L) +
+                            ((long long)nowsec) - ((long long)starttime));
+    }
+    atime = (time > 0) ? time : animation_time;
+    if (((output == NULL) && (msecs == 0)) || (nowsec >= ((uint32_t)atime)))    {
+        par = 100;
+    }
+    else    {
+        par = (nowsec * 100 + atime / 2) / atime;
+        if (par < 2)    par = 2;
+    }
+    return par;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   animation_cont: continue animation
@@ -263,58 +634,42 @@ animation_cont(struct weston_animation *animation, struct weston_output *output,
     struct uifw_win_surface *usurf;
     struct animation_data   *animadata;
     int         par;
-    uint32_t    nowsec;
-    struct timeval  nowtv;
-    int         time;
-
-    gettimeofday(&nowtv, NULL);
-    nowsec = (uint32_t)(((long long)nowtv.tv_sec) * 1000L +
-                        ((long long)nowtv.tv_usec) / 1000L);
 
     usurf = container_of(animation, struct uifw_win_surface, animation.animation);
 
     if (animation->frame_counter <= 1)  {
         /* first call, initialize           */
         animation->frame_counter = 1;
-        usurf->animation.starttime = nowsec;
+        usurf->animation.starttime = animation_now();
         usurf->animation.current = 1000;
         if (! usurf->animadata) {
-            if (free_data)  {
-                usurf->animadata = (void *)free_data;
-                free_data = free_data->next_free;
+            usurf->animadata = (void *)animation_data_alloc();
+            if (! usurf->animadata) {
+                /* no memory, end animation without animation   */
+                uifw_error("animation_cont: usurf=%08x no animation data", (int)usurf);
+                wl_list_remove(&animation->link);
+                wl_list_init(&animation->link);
+                animation_end(usurf, 1);
+                return 999;
             }
-            else    {
-                usurf->animadata = (void *)malloc(sizeof(struct animation_data));
-            }
-            memset(usurf->animadata, 0, sizeof(struct animation_data));
         }
         animadata = (struct animation_data *)usurf->animadata;
-        animadata->x = usurf->x;
-        animadata->y = usurf->y;
-        animadata->width = usurf->width;
-        animadata->height = usurf->height;
-        animadata->geometry_saved = 1;
+        if (animadata->geometry_saved == 0) {
+            /* restart of running animation keeps original geometry */
+            animadata->x = usurf->x;
+            animadata->y = usurf->y;
+            animadata->width = usurf->width;
+            animadata->height = usurf->height;
+            animadata->geometry_saved = 1;
+        }
     }
     else if (! usurf->animadata)    {
         animation_end(usurf, 0);
         return 999;
     }
 
-    if (nowsec >= usurf->animation.starttime)   {
-        nowsec = nowsec - usurf->animation.starttime;   /* elapsed time(ms) */
-    }
-    else    {
-        nowsec = (uint32_t)(((long long)0x100000000L) +
-                            ((long long)nowsec) - ((long long)usurf->animation.starttime));
-    }
-    time = (usurf->animation.time > 0) ? usurf->animation.time : animation_time;
-    if (((output == NULL) && (msecs == 0)) || (nowsec >= ((uint32_t)time))) {
-        par = 100;
-    }
-    else    {
-        par = (nowsec * 100 + time / 2) / time;
-        if (par < 2)    par = 2;
-    }
+    par = animation_par(usurf->animation.starttime, usurf->animation.time,
+                        output, msecs);
     if ((par >= 100) ||
         (abs(usurf->animation.current - par) >= animation_fpar)) {
         usurf->animation.current = par;
@@ -372,16 +727,138 @@ animation_end(struct uifw_win_surface *usurf, const int disp)
             weston_surface_damage_below(usurf->surface);
             weston_surface_damage(usurf->surface);
         }
-        ivi_shell_restrain_configure(usurf->shsurf, 0);
+        ico_window_mgr_restrain_configure(usurf, 0);
         weston_compositor_schedule_repaint(weston_ec);
     }
     usurf->animation.visible = ANIMA_NOCONTROL_AT_END;
     usurf->animation.type = usurf->animation.type_next;
     if (animadata)   {
         usurf->animadata = NULL;
+        animation_data_free(animadata);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_pool_grow: add animation datas to free list
+ *
+ * @param[in]   num         number of animation datas
+ * @return      number of added animation datas
+ */
+/*--------------------------------------------------------------------------*/
+static int
+animation_pool_grow(const int num)
+{
+    struct animation_chunk  *chunk;
+    int     i;
+    int     n = num;
+
+    if ((pool.max > 0) && ((pool.size + n) > pool.max)) {
+        n = pool.max - pool.size;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+    /* chunk is released at unload only, datas return to free list  */
+    chunk = (struct animation_chunk *)malloc(sizeof(struct animation_chunk) +
+                                             sizeof(struct animation_data) * n);
+    if (! chunk)    {
+        uifw_warn("animation_pool_grow: No Memory(%d)", n);
+        return 0;
+    }
+    chunk->next = chunks;
+    chunks = chunk;
+    for (i = 0; i < n; i++) {
+        chunk->data[i].pooled = 1;
+        chunk->data[i].next_free = free_data;
+        free_data = &chunk->data[i];
+    }
+    pool.size += n;
+    uifw_trace("animation_pool_grow: pool size=%d(+%d) live=%d", pool.size, n, pool.live);
+    return n;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_data_alloc: allocate animation data
+ *
+ * @param       none
+ * @return      animation data
+ * @retval      !=NULL      success(animation data address)
+ * @retval      NULL        error(no memory)
+ */
+/*--------------------------------------------------------------------------*/
+static struct animation_data *
+animation_data_alloc(void)
+{
+    struct animation_data   *animadata;
+
+    if ((! free_data) && (animation_pool_grow(pool.chunk) <= 0))    {
+        /* pool is full, allocate out of pool   */
+        animadata = (struct animation_data *)malloc(sizeof(struct animation_data));
+        if (! animadata)    {
+            pool.failed ++;
+            uifw_error("animation_data_alloc: No Memory(live=%d failed=%d)",
+                       pool.live, pool.failed);
+            return NULL;
+        }
+        memset(animadata, 0, sizeof(struct animation_data));
+        pool.fallback ++;
+        uifw_warn("animation_data_alloc: pool(%d) exhausted, fallback=%d",
+                  pool.size, pool.fallback);
+    }
+    else    {
+        animadata = free_data;
+        free_data = free_data->next_free;
+        memset(animadata, 0, sizeof(struct animation_data));
+        animadata->pooled = 1;
+    }
+    pool.live ++;
+    if (pool.live > pool.peak)  {
+        pool.peak = pool.live;
+        uifw_info("animation_data_alloc: peak=%d pool=%d fallback=%d",
+                  pool.peak, pool.size, pool.fallback);
+    }
+    return animadata;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_data_free: release animation data
+ *
+ * @param[in]   animadata   animation data
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_data_free(struct animation_data *animadata)
+{
+    pool.live --;
+    if (animadata->pooled)  {
         animadata->next_free = free_data;
         free_data = animadata;
     }
+    else    {
+        free(animadata);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_window_animation_pool_stat: get animation data pool statistics
+ *
+ * @param[out]  stat        pool statistics
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT void
+ico_window_animation_pool_stat(struct uifw_animation_pool_stat *stat)
+{
+    stat->size = pool.size;
+    stat->live = pool.live;
+    stat->peak = pool.peak;
+    stat->fallback = pool.fallback;
+    stat->failed = pool.failed;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -400,9 +877,8 @@ animation_slide(struct weston_animation *animation,
 {
     struct uifw_win_surface *usurf;
     struct animation_data   *animadata;
-    struct weston_surface   *es;
-    int         dwidth, dheight;
     int         par;
+    uifw_watch("animation.slide_frame", animation, msecs);
 
     usurf = container_of(animation, struct uifw_win_surface, animation.animation);
 
@@ -410,6 +886,7 @@ animation_slide(struct weston_animation *animation,
     if (par > 0)    {
         uifw_trace("animation_slide: usurf=%08x count=%d %d%% skip",
                    (int)usurf, animation->frame_counter, par);
+        ico_ivi_metric_add(m_skip, 1);
         /* continue animation   */
         if( par <= 100) {
             weston_compositor_schedule_repaint(weston_ec);
@@ -422,18 +899,53 @@ animation_slide(struct weston_animation *animation,
     uifw_trace("animation_slide: usurf=%08x count=%d %d%% type=%d state=%d",
                (int)usurf, animation->frame_counter, par,
                usurf->animation.type, usurf->animation.state);
+    uifw_btrace(ICO_TP_ANIMA_SLIDE, (int)usurf, animation->frame_counter, par,
+                usurf->animation.state);
 
-    es = usurf->surface;
+    animation_slide_step(usurf, par);
+
+    if (par >= 100) {
+        /* end of animation     */
+        animadata->geometry_saved ++;       /* restore geometry     */
+        animation_end(usurf, 1);
+        uifw_trace("animation_slide: End of animation");
+    }
+    else    {
+        /* continue animation   */
+        weston_compositor_schedule_repaint(weston_ec);
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_slide_position: surface position at percentage
+ *
+ * @param[in]   usurf       UIFW surface table
+ * @param[in]   par         percentage
+ * @param[out]  x           X coordinate
+ * @param[out]  y           Y coordinate
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_slide_position(struct uifw_win_surface *usurf, const int par, int *x, int *y)
+{
+    struct animation_data   *animadata;
+    int         dwidth, dheight;
 
-    switch (usurf->animation.type)  {
+    animadata = (struct animation_data *)usurf->animadata;
+    *x = animadata->x;
+    *y = animadata->y;
+
+    switch (ANIMATION_KIND(usurf))  {
     case ANIMA_SLIDE_TORIGHT:           /* slide in left to right           */
         if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)    {
             /* slide in left to right   */
-            usurf->x = 0 - ((animadata->x + animadata->width) * (100 - par) / 100);
+            *x = 0 - ((animadata->x + animadata->width) * (100 - par) / 100);
         }
         else    {
             /* slide out right to left  */
-            usurf->x = 0 - ((animadata->x + animadata->width) * par / 100);
+            *x = 0 - ((animadata->x + animadata->width) * par / 100);
         }
         break;
     case ANIMA_SLIDE_TOLEFT:            /* slide in right to left           */
@@ -441,21 +953,21 @@ animation_slide(struct weston_animation *animation,
                                struct weston_output, link))->width;
         if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)    {
             /* slide in right to left   */
-            usurf->x = animadata->x + (dwidth - animadata->x) * (100 - par) / 100;
+            *x = animadata->x + (dwidth - animadata->x) * (100 - par) / 100;
         }
         else    {
             /* slide out left to right  */
-            usurf->x = animadata->x + (dwidth - animadata->x) * par / 100;
+            *x = animadata->x + (dwidth - animadata->x) * par / 100;
         }
         break;
     case ANIMA_SLIDE_TOBOTTOM:          /* slide in top to bottom           */
         if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)    {
             /* slide in top to bottom   */
-            usurf->y = 0 - ((animadata->y + animadata->height) * (100 - par) / 100);
+            *y = 0 - ((animadata->y + animadata->height) * (100 - par) / 100);
         }
         else    {
             /* slide out bottom to top  */
-            usurf->y = 0 - ((animadata->y + animadata->height) * par / 100);
+            *y = 0 - ((animadata->y + animadata->height) * par / 100);
         }
         break;
     default: /*ANIMA_SLIDE_TOTOP*/      /* slide in bottom to top           */
@@ -463,14 +975,44 @@ animation_slide(struct weston_animation *animation,
                                 struct weston_output, link))->height;
         if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)    {
             /* slide in bottom to top   */
-            usurf->y = animadata->y + (dheight - animadata->y) * (100 - par) / 100;
+            *y = animadata->y + (dheight - animadata->y) * (100 - par) / 100;
         }
         else    {
             /* slide out top to bottom  */
-            usurf->y = animadata->y + (dheight - animadata->y) * par / 100;
+            *y = animadata->y + (dheight - animadata->y) * par / 100;
         }
         break;
     }
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_slide_step: set surface position at current percentage
+ *
+ * @param[in]   usurf       UIFW surface table
+ * @param[in]   par         current percentage
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_slide_step(struct uifw_win_surface *usurf, const int par)
+{
+    struct animation_data   *animadata;
+    struct weston_surface   *es;
+    int         x, y;
+
+    animadata = (struct animation_data *)usurf->animadata;
+    es = usurf->surface;
+
+    if (animadata->blend)   {
+        /* from retarget point to target    */
+        animation_slide_position(usurf, 100, &x, &y);
+        usurf->x = animation_blend(animadata->from_x, x, animadata->from_par, par);
+        usurf->y = animation_blend(animadata->from_y, y, animadata->from_par, par);
+    }
+    else    {
+        animation_slide_position(usurf, par, &usurf->x, &usurf->y);
+    }
 
     es->geometry.x = usurf->x;
     es->geometry.y = usurf->y;
@@ -481,16 +1023,6 @@ animation_slide(struct weston_animation *animation,
         weston_surface_damage_below(es);
         weston_surface_damage(es);
     }
-    if (par >= 100) {
-        /* end of animation     */
-        animadata->geometry_saved ++;       /* restore geometry     */
-        animation_end(usurf, 1);
-        uifw_trace("animation_slide: End of animation");
-    }
-    else    {
-        /* continue animation   */
-        weston_compositor_schedule_repaint(weston_ec);
-    }
 }
 
 /*--------------------------------------------------------------------------*/
@@ -508,9 +1040,8 @@ animation_fade(struct weston_animation *animation,
                struct weston_output *output, uint32_t msecs)
 {
     struct uifw_win_surface *usurf;
-    struct animation_data   *animadata;
-    struct weston_surface   *es;
     int         par;
+    uifw_watch("animation.fade_frame", animation, msecs);
 
     usurf = container_of(animation, struct uifw_win_surface, animation.animation);
 
@@ -518,6 +1049,7 @@ animation_fade(struct weston_animation *animation,
     if (par > 0)    {
         uifw_trace("animation_fade: usurf=%08x count=%d %d%% skip",
                    (int)usurf, animation->frame_counter, par);
+        ico_ivi_metric_add(m_skip, 1);
         /* continue animation   */
         if( par <= 100) {
             weston_compositor_schedule_repaint(weston_ec);
@@ -525,25 +1057,60 @@ animation_fade(struct weston_animation *animation,
         return;
     }
 
-    animadata = (struct animation_data *)usurf->animadata;
-    es = usurf->surface;
     par = usurf->animation.current;
-    if (animation->frame_counter == 1)  {
-        if (animadata->transform_set == 0)  {
-            animadata->transform_set = 1;
-            weston_matrix_init(&animadata->transform.matrix);
-            wl_list_init(&animadata->transform.link);
-            wl_list_insert(&es->geometry.transformation_list,
-                           &animadata->transform.link);
-        }
-        animadata->end_function = animation_fade_end;
-    }
 
     uifw_trace("animation_fade: usurf=%08x count=%d %d%% type=%d state=%d",
                (int)usurf, animation->frame_counter, par,
                usurf->animation.type, usurf->animation.state);
+    uifw_btrace(ICO_TP_ANIMA_FADE, (int)usurf, animation->frame_counter, par,
+                usurf->animation.state);
+
+    animation_fade_step(usurf, par);
+
+    if (par >= 100) {
+        /* end of animation     */
+        animation_end(usurf, 1);
+        uifw_trace("animation_fade: End of animation");
+    }
+    else    {
+        /* continue animation   */
+        weston_compositor_schedule_repaint(weston_ec);
+    }
+}
 
-    if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)    {
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_fade_step: set surface alpha at current percentage
+ *
+ * @param[in]   usurf       UIFW surface table
+ * @param[in]   par         current percentage
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_fade_step(struct uifw_win_surface *usurf, const int par)
+{
+    struct animation_data   *animadata;
+    struct weston_surface   *es;
+
+    animadata = (struct animation_data *)usurf->animadata;
+    es = usurf->surface;
+    if (animadata->transform_set == 0)  {
+        animadata->transform_set = 1;
+        weston_matrix_init(&animadata->transform.matrix);
+        wl_list_init(&animadata->transform.link);
+        wl_list_insert(&es->geometry.transformation_list,
+                       &animadata->transform.link);
+        animadata->end_function = animation_fade_end;
+    }
+
+    if (animadata->blend)   {
+        /* from retarget point to target    */
+        es->alpha = ((double)animation_blend((int)(animadata->from_alpha * 1000.0),
+                        (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN) ?
+                            1000 : 0, animadata->from_par, par)) / ((double)1000.0);
+    }
+    else if (usurf->animation.state == ICO_WINDOW_MGR_ANIMATION_STATE_IN)   {
         /* fade in                  */
         es->alpha = ((double)par) / ((double)100.0);
     }
@@ -559,15 +1126,6 @@ animation_fade(struct weston_animation *animation,
         weston_surface_damage_below(es);
         weston_surface_damage(es);
     }
-    if (par >= 100) {
-        /* end of animation     */
-        animation_end(usurf, 1);
-        uifw_trace("animation_fade: End of animation");
-    }
-    else    {
-        /* continue animation   */
-        weston_compositor_schedule_repaint(weston_ec);
-    }
 }
 
 /*--------------------------------------------------------------------------*/
@@ -595,6 +1153,25 @@ animation_fade_end(struct weston_animation *animation)
     }
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_reload: get default animation from ico_ivi_shell
+ *                            (at initialize and configuration changed)
+ *
+ * @param[in]   data        user data(unused)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+animation_reload(void *data)
+{
+    default_animation = (char *)ivi_shell_default_animation(&animation_time,
+                                                            &animation_fpar);
+    animation_fpar = ((1000 * 100) / animation_fpar) / animation_time;
+    uifw_info("animation_reload: default=%s time=%dms frame=%d%%",
+              default_animation, animation_time, animation_fpar);
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   module_init: initialize ico_window_animation
@@ -610,31 +1187,104 @@ WL_EXPORT int
 module_init(struct weston_compositor *ec)
 {
     int     i;
-    struct animation_data   *animadata;
+    int     pool_initial = ANIMA_POOL_INITIAL;
+
+    struct config_key animation_keys[] = {
+        { "pool_initial",   CONFIG_KEY_INTEGER, &pool_initial },
+        { "pool_chunk",     CONFIG_KEY_INTEGER, &pool.chunk },
+        { "pool_max",       CONFIG_KEY_INTEGER, &pool.max },
+    };
+
+    struct config_section cs[] = {
+        { "animation", animation_keys, ARRAY_LENGTH(animation_keys), NULL },
+    };
 
     uifw_info("ico_window_animation: Enter(module_init)");
 
+    memset(&pool, 0, sizeof(pool));
+    pool.chunk = ANIMA_POOL_CHUNK;
+    pool.max = ANIMA_POOL_MAX;
+
+    ico_ivi_conf_parse(cs, ARRAY_LENGTH(cs), NULL);
+
+    if (pool_initial < 0)   pool_initial = 0;
+    if (pool.chunk < 1)     pool.chunk = 1;
+    if (pool.max < 0)       pool.max = ANIMA_POOL_MAX;
+    if ((pool.max > 0) && (pool_initial > pool.max))    pool_initial = pool.max;
+
     /* allocate animation datas     */
     free_data = NULL;
-    for (i = 0; i < 50; i++)    {
-        animadata = (struct animation_data *)malloc(sizeof(struct animation_data));
-        if (! animadata)    {
-            uifw_error("ico_window_animation: No Memory(module_init)");
-            return -1;
-        }
-        animadata->next_free = free_data;
-        free_data = animadata;
+    chunks = NULL;
+    if (animation_pool_grow(pool_initial) < pool_initial)   {
+        uifw_error("ico_window_animation: No Memory(module_init)");
+        return -1;
     }
+    uifw_info("ico_window_animation: pool initial=%d chunk=%d max=%d",
+              pool_initial, pool.chunk, pool.max);
 
     weston_ec = ec;
-    default_animation = (char *)ivi_shell_default_animation(&animation_time,
-                                                            &animation_fpar);
-    animation_fpar = ((1000 * 100) / animation_fpar) / animation_time;
+    animation_reload(NULL);
+    ico_ivi_conf_add_reload(animation_reload, NULL);
+    m_skip = ico_ivi_metric_regist("animation.frames_skipped", ICO_IVI_METRIC_COUNTER);
 
-    ico_window_mgr_set_animation(ico_window_animation);
+    /* regist animations to ico_window_mgr  */
+    for (i = 0; i < (int)ANIMATION_TYPES; i++)  {
+        if (ico_window_mgr_regist_animation(animation_types[i].name,
+                                            &animation_types[i].ops) <= 0)  {
+            uifw_error("ico_window_animation: Can not regist %s(module_init)",
+                       animation_types[i].name);
+        }
+    }
 
     uifw_info("ico_window_animation: Leave(module_init)");
 
     return 0;
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   module_exit: terminate ico_window_animation before unload
+ *                       this function called from ico_pluign_loader
+ *
+ * @param[in]   es          weston compositor
+ * @return      result
+ * @retval      0           sccess(may be unloaded)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+module_exit(struct weston_compositor *ec)
+{
+    struct animation_chunk  *chunk;
+    int     i;
+
+    uifw_info("ico_window_animation: Enter(module_exit)");
+
+    /* unregist animations, ico_window_mgr cancels running animations   */
+    /* (animation type values remain, and are used after reload)        */
+    for (i = 0; i < (int)ANIMATION_TYPES; i++)  {
+        ico_window_mgr_unregist_animation(&animation_types[i].ops);
+    }
+    ico_ivi_conf_remove_reload(animation_reload, NULL);
+
+    /* release animation data pool  */
+    if (pool.live > 0)  {
+        /* animation data still in use, leave pool(memory leak)   */
+        uifw_warn("ico_window_animation: %d animation datas in use, pool not released",
+                  pool.live);
+    }
+    else    {
+        while (chunks)  {
+            chunk = chunks;
+            chunks = chunk->next;
+            free(chunk);
+        }
+    }
+    chunks = NULL;
+    free_data = NULL;
+    m_skip = NULL;
+
+    uifw_info("ico_window_animation: Leave(module_exit)");
+
+    return 0;
+}
+
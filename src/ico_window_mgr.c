@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <ctype.h>
 #include <unistd.h>
 #include <linux/input.h>
 #include <assert.h>
@@ -53,11 +54,15 @@
 #include "ico_ivi_shell-server-protocol.h"
 #include "ico_window_mgr-server-protocol.h"
 
+/* Plugins that must be loaded before this plugin    */
+ICO_PLUGIN_DEPENDS("ico_ivi_common.so,ico_ivi_shell.so");
+
 /* SurfaceID                        */
 #define INIT_SURFACE_IDS    1024            /* SurfaceId table initiale size        */
 #define ADD_SURFACE_IDS     512             /* SurfaceId table additional size      */
 #define SURCAFE_ID_MASK     0x0ffff         /* SurfaceId bit mask pattern           */
 #define UIFW_HASH    64                     /* Hash value (2's compliment)          */
+#define ANIMATION_HASH  32                  /* Animation name hash (2's compliment) */
 
 /* Client attribute table           */
 #define MAX_CLIENT_ATTR     4
@@ -71,6 +76,14 @@ struct uifw_client_attr {
     struct wl_list  link;
 };
 
+/* Animation table                  */
+struct uifw_animation {
+    char    name[ICO_WINDOW_ANIMATION_LEN]; /* animation name                       */
+    uint32_t hash;                          /* hash value of animation name         */
+    const struct uifw_animation_ops *ops;   /* animation operation(NULL=unregisted) */
+    struct uifw_animation *next_hash;       /* animation name hash list             */
+};
+
 /* Manager table                    */
 struct uifw_manager {
     struct wl_resource *resource;           /* Manager resource                     */
@@ -88,15 +101,25 @@ struct ico_win_mgr {
     int             num_manager;            /* Number of managers                   */
     struct wl_list  surface_list;           /* Surface list                         */
     struct wl_list  client_attr_list;       /* Client attribute list                */
+    struct wl_list  layer_animation_list;   /* Running layer animation list         */
     struct uifw_win_surface *active_pointer_surface;    /* Active Pointer Surface   */
     struct uifw_win_surface *active_keyboard_surface;   /* Active Keyboard Surface  */
 
     struct uifw_win_surface *idhash[UIFW_HASH];  /* UIFW SerfaceID                  */
     struct uifw_win_surface *wshash[UIFW_HASH];  /* Weston Surface                  */
 
+    int     num_animation;                  /* Number of animation type             */
+    struct uifw_animation animation[ICO_WINDOW_MGR_ANIMATION_MAX];
+                                            /* Animation table(type = index + 1)    */
+    struct uifw_animation *animation_hash[ANIMATION_HASH];
+                                            /* Animation name hash                  */
+
     uint32_t surfaceid_count;               /* Number of surface id                 */
     uint32_t surfaceid_max;                 /* Maximum number of surface id         */
     uint16_t *surfaceid_map;                /* SurfaceId assign bit map             */
+
+    struct ico_ivi_metric *m_surfaces;      /* metric: number of live surfaces      */
+    struct ico_ivi_metric *m_events;        /* metric: events sent to managers      */
 };
 
 /* Internal macros                      */
@@ -104,6 +127,8 @@ struct ico_win_mgr {
 #define MAKE_IDHASH(v)  (((uint32_t)v) & (UIFW_HASH-1))
 /* Weston Surface                       */
 #define MAKE_WSHASH(v)  ((((uint32_t)v) >> 5) & (UIFW_HASH-1))
+/* Animation name                       */
+#define MAKE_ANIMAHASH(v)   (((uint32_t)v) & (ANIMATION_HASH-1))
 
 /* function prototype                   */
                                             /* weston compositor interface          */
@@ -118,16 +143,17 @@ static struct uifw_client* find_client_from_client(struct wl_client* client);
                                             /* assign new surface id                */
 static uint32_t generate_id(void);
                                             /* bind shell client                    */
-static void bind_shell_client(struct wl_client *client);
+static void bind_shell_client(struct wl_client *client, void *data);
                                             /* unind shell client                   */
-static void unbind_shell_client(struct wl_client *client);
+static void unbind_shell_client(struct wl_client *client, void *data);
                                             /* create new surface                   */
 static void client_register_surface(
                     struct wl_client *client, struct wl_resource *resource,
-                    struct weston_surface *surface, struct shell_surface *shsurf);
+                    struct weston_surface *surface, struct shell_surface *shsurf,
+                    void *data);
                                             /* map new surface                      */
 static void win_mgr_map_surface(struct weston_surface *surface, int32_t *width,
-                                int32_t *height, int32_t *sx, int32_t *sy);
+                                int32_t *height, int32_t *sx, int32_t *sy, void *data);
                                             /* set applicationId for RemoteUI       */
 static void uifw_set_user(struct wl_client *client, struct wl_resource *resource,
                           int pid, const char *appid);
@@ -154,17 +180,22 @@ static void uifw_set_active(struct wl_client *client, struct wl_resource *resour
                                             /* layer visibility control             */
 static void uifw_set_layer_visible(struct wl_client *client, struct wl_resource *resource,
                                    int32_t layer, int32_t visible);
+                                            /* layer visible control with animation */
+static void uifw_set_layer_visible_animation(struct wl_client *client,
+                                             struct wl_resource *resource,
+                                             int32_t layer, int32_t visible,
+                                             const char *animation, int32_t time);
                                             /* send surface change event to manager */
 static void uifw_set_client_attr(struct wl_client *client, struct wl_resource *resource,
                                  const char *appid, int32_t attr, int32_t value);
                                             /* set client application attribute     */
 static void win_mgr_surface_change(struct weston_surface *surface,
-                                   const int to, const int manager);
+                                   const int to, const int manager, void *data);
                                             /* surface change from manager          */
 static int win_mgr_surface_change_mgr(struct weston_surface *surface, const int x,
                                       const int y, const int width, const int height);
                                             /* surface destory                      */
-static void win_mgr_surface_destroy(struct weston_surface *surface);
+static void win_mgr_surface_destroy(struct weston_surface *surface, void *data);
                                             /* bind manager                         */
 static void bind_ico_win_mgr(struct wl_client *client,
                              void *data, uint32_t version, uint32_t id);
@@ -179,17 +210,20 @@ static int ico_win_mgr_send_to_mgr(const int event, const int surfaceid,
                                    const int param5, const int param6);
                                             /* convert animation name to type value */
 static int ico_get_animation_type(const char *animation);
-                                            /* hook for set user                    */
-static void (*win_mgr_hook_set_user)
-                (struct wl_client *client, const char *appid) = NULL;
-                                            /* hook for surface create              */
-static void (*win_mgr_hook_create)
-                (struct wl_client *client, struct weston_surface *surface,
-                 int surfaceId, const char *appid) = NULL;
-                                            /* hook for surface destory             */
-static void (*win_mgr_hook_destroy)(struct weston_surface *surface) = NULL;
-                                            /* hook for animation                   */
-static int  (*win_mgr_hook_animation)(const int op, void *data) = NULL;
+                                            /* call animation operation             */
+static int win_mgr_animation(const int op, struct uifw_win_surface *usurf);
+                                            /* end of layer animation               */
+static void win_mgr_layer_animation_end(struct uifw_layer_animation *layer_animation);
+                                            /* remove surface from layer animation  */
+static void win_mgr_layer_animation_remove(struct uifw_win_surface *usurf);
+                                            /* finish running layer animation       */
+static void win_mgr_layer_animation_finish(const int layer);
+                                            /* hook chain for set user              */
+static struct ico_ivi_hook_chain win_mgr_hook_set_user = { 0, 0, NULL, 0 };
+                                            /* hook chain for surface create        */
+static struct ico_ivi_hook_chain win_mgr_hook_create = { 0, 0, NULL, 0 };
+                                            /* hook chain for surface destory       */
+static struct ico_ivi_hook_chain win_mgr_hook_destroy = { 0, 0, NULL, 0 };
 
 /* static tables                        */
 /* Multi Window Manager interface       */
@@ -202,7 +236,8 @@ static const struct ico_window_mgr_interface ico_window_mgr_implementation = {
     uifw_set_animation,
     uifw_set_active,
     uifw_set_layer_visible,
-    uifw_set_client_attr
+    uifw_set_client_attr,
+    uifw_set_layer_visible_animation
 };
 
 /* static management table              */
@@ -393,7 +428,7 @@ generate_id(void)
  */
 /*--------------------------------------------------------------------------*/
 static void
-bind_shell_client(struct wl_client *client)
+bind_shell_client(struct wl_client *client, void *data)
 {
     struct uifw_client  *uclient;
     struct uifw_client_attr *lattr;
@@ -405,6 +440,7 @@ bind_shell_client(struct wl_client *client)
     int     i;
     int     j;
     char    procpath[128];
+    uifw_watch("window_mgr.hook_bind", client, 0);
 
     uifw_trace("bind_shell_client: Enter(client=%08x)", (int)client);
 
@@ -518,9 +554,10 @@ bind_shell_client(struct wl_client *client)
  */
 /*--------------------------------------------------------------------------*/
 static void
-unbind_shell_client(struct wl_client *client)
+unbind_shell_client(struct wl_client *client, void *data)
 {
     struct uifw_client  *uclient;
+    uifw_watch("window_mgr.hook_unbind", client, 0);
 
     uifw_trace("unbind_shell_client: Enter(client=%08x)", (int)client);
 
@@ -533,6 +570,54 @@ unbind_shell_client(struct wl_client *client)
     uifw_trace("unbind_shell_client: Leave");
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   animation_name_hash: make hash value of animation name
+ *
+ * @param[in]   name            animation name(not case sensitive)
+ * @return      hash value
+ */
+/*--------------------------------------------------------------------------*/
+static uint32_t
+animation_name_hash(const char *name)
+{
+    uint32_t    hash = 2166136261U;         /* FNV-1a                               */
+
+    for (; *name; name++)   {
+        hash ^= (uint32_t)tolower((unsigned char)*name);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   find_animation_by_name: find animation table by animation name
+ *
+ * @param[in]   name            animation name
+ * @return      animation table address
+ * @retval      !=NULL          success(animation table address)
+ * @retval      NULL            error(animation dose not exist)
+ */
+/*--------------------------------------------------------------------------*/
+static struct uifw_animation *
+find_animation_by_name(const char *name)
+{
+    struct uifw_animation   *anima;
+    uint32_t    hash;
+
+    hash = animation_name_hash(name);
+    anima = _ico_win_mgr->animation_hash[MAKE_ANIMAHASH(hash)];
+
+    while (anima)   {
+        if ((anima->hash == hash) && (strcasecmp(anima->name, name) == 0))  {
+            return anima;
+        }
+        anima = anima->next_hash;
+    }
+    return NULL;
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   ico_get_animation_type: convert animation name to type value
@@ -544,19 +629,88 @@ unbind_shell_client(struct wl_client *client)
 static int
 ico_get_animation_type(const char *animation)
 {
-    int anima = ICO_WINDOW_MGR_ANIMATION_NONE;
+    struct uifw_animation   *anima;
 
-    if (strcasecmp(animation, "none") == 0) {
+    anima = find_animation_by_name(animation);
+    if ((! anima) || (! anima->ops))    {
+        if (strcasecmp(animation, "none") != 0) {
+            uifw_warn("ico_get_animation_type: Unknown Type %s", animation);
+        }
         return ICO_WINDOW_MGR_ANIMATION_NONE;
     }
+    uifw_trace("ico_get_animation_type: Type %s=>%d", animation,
+               (int)(anima - _ico_win_mgr->animation) + 1);
+    return (int)(anima - _ico_win_mgr->animation) + 1;
+}
 
-    if (win_mgr_hook_animation) {
-        anima = (*win_mgr_hook_animation)(ICO_WINDOW_MGR_ANIMATION_TYPE, (void *)animation);
-    }
-    if (anima <= 0) {
-        anima = ICO_WINDOW_MGR_ANIMATION_NONE;
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   win_mgr_animation: call animation operation of surface
+ *
+ * @param[in]   op              animation operation
+ * @param[in]   usurf           UIFW surface
+ * @return      result
+ * @retval      ICO_WINDOW_MGR_ANIMATION_RET_ANIMA      success
+ * @retval      ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW  success(force visible)
+ * @retval      ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA    error(no animation)
+ */
+/*--------------------------------------------------------------------------*/
+static int
+win_mgr_animation(const int op, struct uifw_win_surface *usurf)
+{
+    const struct uifw_animation_ops *ops;
+    int     type;
+
+    switch (op) {
+    case ICO_WINDOW_MGR_ANIMATION_OPIN:
+    case ICO_WINDOW_MGR_ANIMATION_OPOUT:
+        type = usurf->animation.type;
+        if ((type <= 0) || (type > ICO_WINDOW_MGR_ANIMATION_MAX))   {
+            return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
+        }
+        ops = _ico_win_mgr->animation[type - 1].ops;
+        if ((! ops) || (! ops->start))  {
+            return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
+        }
+        if ((usurf->animation.ops != NULL) && (usurf->animation.ops != ops) &&
+            (usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) &&
+            (usurf->animation.ops->cancel != NULL)) {
+            /* other animation running, cancel it   */
+            (*usurf->animation.ops->cancel)(usurf);
+        }
+        usurf->animation.ops = ops;
+        return (*ops->start)(usurf, op);
+
+    case ICO_WINDOW_MGR_ANIMATION_OPMOVE:
+    case ICO_WINDOW_MGR_ANIMATION_OPRESIZE:
+        /* retarget running animation   */
+        ops = usurf->animation.ops;
+        if ((ops) && (ops->start) &&
+            (usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE))    {
+            return (*ops->start)(usurf, op);
+        }
+        break;
+
+    case ICO_WINDOW_MGR_ANIMATION_OPCANCEL:
+        ops = usurf->animation.ops;
+        if ((ops) && (ops->cancel)) {
+            (*ops->cancel)(usurf);
+            return ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
+        }
+        break;
+
+    case ICO_WINDOW_MGR_ANIMATION_DESTROY:
+        ops = usurf->animation.ops;
+        if ((ops) && (ops->end))    {
+            (*ops->end)(usurf);
+        }
+        usurf->animation.ops = NULL;
+        break;
+
+    default:
+        break;
     }
-    return anima;
+    return ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -572,14 +726,17 @@ ico_get_animation_type(const char *animation)
 /*--------------------------------------------------------------------------*/
 static void
 client_register_surface(struct wl_client *client, struct wl_resource *resource,
-                        struct weston_surface *surface, struct shell_surface *shsurf)
+                        struct weston_surface *surface, struct shell_surface *shsurf,
+                        void *data)
 {
     struct uifw_win_surface *us;
     struct uifw_win_surface *phash;
     struct uifw_win_surface *bhash;
     struct uifw_client_attr *lattr;
+    struct ico_ivi_hook     *hook;
     uint32_t    hash;
     int         i;
+    uifw_watch("window_mgr.hook_create", client, surface);
 
     uifw_trace("client_register_surface: Enter(surf=%08x,client=%08x,res=%08x)",
                (int)surface, (int)client, (int)resource);
@@ -599,6 +756,7 @@ client_register_surface(struct wl_client *client, struct wl_resource *resource,
     }
 
     memset(us, 0, sizeof(struct uifw_win_surface));
+    ico_ivi_metric_add(_ico_win_mgr->m_surfaces, 1);
 
     us->id = generate_id();
     us->surface = surface;
@@ -621,7 +779,7 @@ client_register_surface(struct wl_client *client, struct wl_resource *resource,
     if (! us->uclient)  {
         /* client not exist, create client management table */
         uifw_trace("client_register_surface: Create Client");
-        bind_shell_client(client);
+        bind_shell_client(client, NULL);
         us->uclient = find_client_from_client(client);
         if (! us->uclient)  {
             uifw_error("client_register_surface: No Memory");
@@ -687,9 +845,11 @@ client_register_surface(struct wl_client *client, struct wl_resource *resource,
     ico_win_mgr_send_to_mgr(ICO_WINDOW_MGR_WINDOW_CREATED,
                             us->id, us->uclient->appid, us->uclient->pid, 0,0,0,0,0);
 
-    if (win_mgr_hook_create) {
-        /* call surface create hook for other plugin  */
-        (void) (*win_mgr_hook_create)(client, surface, us->id, us->uclient->appid);
+    /* call surface create hook for other plugin  */
+    ico_ivi_hook_for_each (hook, &win_mgr_hook_create)  {
+        (*(void (*)(struct wl_client *, struct weston_surface *, int, const char *,
+                    void *))hook->func)
+            (client, surface, us->id, us->uclient->appid, hook->data);
     }
     uifw_trace("client_register_surface: Leave(surfaceId=%08x)", us->id);
 }
@@ -708,9 +868,10 @@ client_register_surface(struct wl_client *client, struct wl_resource *resource,
 /*--------------------------------------------------------------------------*/
 static void
 win_mgr_map_surface(struct weston_surface *surface, int32_t *width, int32_t *height,
-                    int32_t *sx, int32_t *sy)
+                    int32_t *sx, int32_t *sy, void *data)
 {
     struct uifw_win_surface *usurf;
+    uifw_watch("window_mgr.hook_map", surface, 0);
 
     uifw_trace("win_mgr_map_surface: Enter(%08x, x/y=%d/%d w/h=%d/%d)",
                (int)surface, *sx, *sy, *width, *height);
@@ -780,6 +941,8 @@ uifw_set_user(struct wl_client *client, struct wl_resource *resource,
               int pid, const char *appid)
 {
     struct uifw_client  *uclient;
+    struct ico_ivi_hook *hook;
+    uifw_watch("window_mgr.set_user", client, pid);
 
     uifw_trace("uifw_set_user: Enter(client=%08x pid=%d appid=%s)",
                 (int)client, pid, appid);
@@ -809,8 +972,9 @@ uifw_set_user(struct wl_client *client, struct wl_resource *resource,
 
     wl_list_insert(&_ico_win_mgr->client_list, &uclient->link);
 
-    if (win_mgr_hook_set_user) {
-        (void) (*win_mgr_hook_set_user) (client, uclient->appid);
+    ico_ivi_hook_for_each (hook, &win_mgr_hook_set_user)    {
+        (*(void (*)(struct wl_client *, const char *, void *))hook->func)
+            (client, uclient->appid, hook->data);
     }
     uifw_trace("uifw_set_user: Leave");
 }
@@ -831,6 +995,7 @@ uifw_set_eventcb(struct wl_client *client, struct wl_resource *resource, int eve
     struct uifw_manager* mgr;
     struct uifw_win_surface *usurf;
     struct uifw_client *uclient;
+    uifw_watch("window_mgr.set_eventcb", client, eventcb);
 
     uifw_trace("uifw_set_eventcb: Enter client=%08x eventcb=%d",
                (int)client, eventcb);
@@ -883,6 +1048,8 @@ static void
 uifw_set_window_layer(struct wl_client *client, struct wl_resource *resource,
                       uint32_t surfaceid, int32_t layer)
 {
+    uifw_watch("window_mgr.set_window_layer", surfaceid, layer);
+
     uifw_trace("uifw_set_window_layer: Enter res=%08x surfaceid=%08x layer=%d",
                (int)resource, surfaceid, layer);
 
@@ -892,12 +1059,19 @@ uifw_set_window_layer(struct wl_client *client, struct wl_resource *resource,
         uifw_trace("uifw_set_window_layer: Leave(No Surface(id=%08x)", surfaceid);
         return;
     }
+    else if ((usurf->shsurf) && (ivi_shell_is_restrain(usurf->shsurf)))    {
+        /* animation running, change at end of animation    */
+        usurf->pending.flags |= ICO_WINDOW_MGR_PENDING_LAYER;
+        usurf->pending.layer = layer;
+        uifw_trace("uifw_set_window_layer: Leave(pending layer %d)", layer);
+        return;
+    }
     else if (usurf->layer != layer) {
         usurf->layer = layer;
         uifw_trace("uifw_set_window_layer: Set Layer(%d) to Shell Surface", layer);
         ivi_shell_set_layer(usurf->shsurf, layer);
 
-        win_mgr_surface_change(usurf->surface, 1, 1);
+        win_mgr_surface_change(usurf->surface, 1, 1, NULL);
     }
     uifw_trace("uifw_set_window_layer: Leave");
 }
@@ -957,6 +1131,7 @@ uifw_set_positionsize(struct wl_client *client, struct wl_resource *resource,
 {
     struct uifw_client *uclient;
     int     cx, cy, cwidth, cheight;
+    uifw_watch("window_mgr.set_positionsize", surfaceid, ((uint32_t)x << 16) | (y & 0x0ffff));
 
     uifw_trace("uifw_set_positionsize: Enter res=%08x surf=%08x x/y/w/h=%d/%d/%d/%d",
                (int)resource, surfaceid, x, y, width, height);
@@ -975,7 +1150,7 @@ uifw_set_positionsize(struct wl_client *client, struct wl_resource *resource,
         if (height > ICO_IVI_MAX_COORDINATE)    height = cheight;
 
         /* check animation                  */
-        if ((ivi_shell_is_restrain(usurf->shsurf)) &&
+        if ((usurf->shsurf) && (ivi_shell_is_restrain(usurf->shsurf)) &&
             (x == usurf->x) && (y == usurf->y) &&
             (width == usurf->width) && (height == usurf->height))   {
             uifw_trace("uifw_set_positionsize: Leave(same position size at animation)");
@@ -1004,6 +1179,40 @@ uifw_set_positionsize(struct wl_client *client, struct wl_resource *resource,
                    (int)es->geometry.x, (int)es->geometry.y,
                    (int)es->geometry.width, (int)es->geometry.height);
 
+        if (usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE)  {
+            /* animation running, retarget to new position/size     */
+            cx = usurf->x;
+            cy = usurf->y;
+            cwidth = usurf->width;
+            cheight = usurf->height;
+            usurf->x = x;
+            usurf->y = y;
+            usurf->width = width;
+            usurf->height = height;
+            if (win_mgr_animation(((width == cwidth) && (height == cheight)) ?
+                                      ICO_WINDOW_MGR_ANIMATION_OPMOVE :
+                                      ICO_WINDOW_MGR_ANIMATION_OPRESIZE,
+                                  usurf) != ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA)  {
+                win_mgr_surface_change(es, 0, 1, NULL);
+                uifw_trace("uifw_set_positionsize: Leave(OK, retarget animation)");
+                return;
+            }
+            usurf->x = cx;
+            usurf->y = cy;
+            usurf->width = cwidth;
+            usurf->height = cheight;
+        }
+        if ((usurf->shsurf) && (ivi_shell_is_restrain(usurf->shsurf)))  {
+            /* surface restrained, change at end of animation   */
+            usurf->pending.flags |= ICO_WINDOW_MGR_PENDING_GEOMETRY;
+            usurf->pending.x = x;
+            usurf->pending.y = y;
+            usurf->pending.width = width;
+            usurf->pending.height = height;
+            uifw_trace("uifw_set_positionsize: Leave(pending)");
+            return;
+        }
+
         usurf->x = x;
         usurf->y = y;
         usurf->width = width;
@@ -1023,7 +1232,7 @@ uifw_set_positionsize(struct wl_client *client, struct wl_resource *resource,
             weston_surface_damage(es);
             weston_compositor_schedule_repaint(_ico_win_mgr->compositor);
         }
-        win_mgr_surface_change(es, 0, 1);
+        win_mgr_surface_change(es, 0, 1, NULL);
 
         uifw_trace("uifw_set_positionsize: Leave(OK,output=%x)", (int)es->output);
     }
@@ -1051,6 +1260,7 @@ uifw_set_visible(struct wl_client *client, struct wl_resource *resource,
     struct uifw_win_surface* usurf;
     struct uifw_client *uclient;
     int         animation;
+    uifw_watch("window_mgr.set_visible", surfaceid, ((uint32_t)visible << 16) | raise);
 
     uifw_trace("uifw_set_visible: Enter(surf=%08x,%d,%d)", surfaceid, visible, raise);
 
@@ -1076,6 +1286,35 @@ uifw_set_visible(struct wl_client *client, struct wl_resource *resource,
         return;
     }
 
+    /* surface leaves the layer animation       */
+    if (usurf->layer_animation) {
+        win_mgr_layer_animation_remove(usurf);
+    }
+
+    if ((uclient) && (usurf->shsurf) && (ivi_shell_is_restrain(usurf->shsurf)))    {
+        if ((visible == ICO_WINDOW_MGR_VISIBLE_SHOW_ANIMATION) ||
+            (visible == ICO_WINDOW_MGR_VISIBLE_HIDE_ANIMATION)) {
+            /* animation request overrides pending visible  */
+            usurf->pending.flags &= ~ICO_WINDOW_MGR_PENDING_VISIBLE;
+        }
+        else    {
+            /* surface restrained, change at end of animation   */
+            if ((visible != ICO_WINDOW_MGR_VISIBLE_NOCHANGE) ||
+                (! (usurf->pending.flags & ICO_WINDOW_MGR_PENDING_VISIBLE)))  {
+                usurf->pending.visible = visible;
+            }
+            if ((raise == ICO_WINDOW_MGR_RAISE_LOWER) ||
+                (raise == ICO_WINDOW_MGR_RAISE_RAISE) ||
+                (! (usurf->pending.flags & ICO_WINDOW_MGR_PENDING_VISIBLE)))  {
+                usurf->pending.raise = raise;
+            }
+            usurf->pending.flags |= ICO_WINDOW_MGR_PENDING_VISIBLE;
+            uifw_trace("uifw_set_visible: Leave(pending %d,%d)",
+                       usurf->pending.visible, usurf->pending.raise);
+            return;
+        }
+    }
+
     if ((visible == ICO_WINDOW_MGR_VISIBLE_SHOW) ||
         (visible == ICO_WINDOW_MGR_VISIBLE_SHOW_ANIMATION))  {
 
@@ -1102,10 +1341,8 @@ uifw_set_visible(struct wl_client *client, struct wl_resource *resource,
             ivi_shell_set_surface_type(usurf->shsurf);
 
             if ((visible == ICO_WINDOW_MGR_VISIBLE_SHOW_ANIMATION) &&
-                (usurf->animation.type != ICO_WINDOW_MGR_ANIMATION_NONE) &&
-                (win_mgr_hook_animation != NULL))   {
-                animation = (*win_mgr_hook_animation)(ICO_WINDOW_MGR_ANIMATION_OPIN,
-                                                      (void *)usurf);
+                (usurf->animation.type != ICO_WINDOW_MGR_ANIMATION_NONE))   {
+                animation = win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_OPIN, usurf);
             }
         }
         else if ((raise != ICO_WINDOW_MGR_RAISE_LOWER) &&
@@ -1124,10 +1361,8 @@ uifw_set_visible(struct wl_client *client, struct wl_resource *resource,
 
             animation = ICO_WINDOW_MGR_ANIMATION_RET_ANIMA;
             if ((visible == ICO_WINDOW_MGR_VISIBLE_HIDE_ANIMATION) &&
-                (usurf->animation.type > 0) &&
-                (win_mgr_hook_animation != NULL))   {
-                animation = (*win_mgr_hook_animation)(ICO_WINDOW_MGR_ANIMATION_OPOUT,
-                                                      (void *)usurf);
+                (usurf->animation.type > 0))    {
+                animation = win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_OPOUT, usurf);
             }
             if (animation != ICO_WINDOW_MGR_ANIMATION_RET_ANIMASHOW)    {
                 ivi_shell_set_visible(usurf->shsurf, 0);
@@ -1189,6 +1424,7 @@ uifw_set_animation(struct wl_client *client, struct wl_resource *resource,
                    uint32_t surfaceid, const char *animation, int time)
 {
     struct uifw_win_surface* usurf = find_uifw_win_surface_by_id(surfaceid);
+    uifw_watch("window_mgr.set_animation", surfaceid, time);
 
     uifw_trace("uifw_set_transition: Enter(surf=%08x, animation=%s, time=%d)",
                surfaceid, animation, time);
@@ -1226,6 +1462,7 @@ uifw_set_active(struct wl_client *client, struct wl_resource *resource,
                 uint32_t surfaceid, uint32_t target)
 {
     struct uifw_win_surface* usurf;
+    uifw_watch("window_mgr.set_active", surfaceid, target);
 
     uifw_trace("uifw_set_active: Enter(surf=%08x,target=%x)", surfaceid, target);
 
@@ -1335,13 +1572,218 @@ static void
 uifw_set_layer_visible(struct wl_client *client, struct wl_resource *resource,
                        int32_t layer, int32_t visible)
 {
+    uifw_watch("window_mgr.set_layer_visible", layer, visible);
+
     uifw_trace("uifw_set_layer_visible: Enter(layer=%d, visilbe=%d)", layer, visible);
 
+    win_mgr_layer_animation_finish(layer);
     ivi_shell_set_layer_visible(layer, visible);
 
     uifw_trace("uifw_set_layer_visible: Leave");
 }
 
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   uifw_set_layer_visible_animation: layer visible control with animation,
+ *                                            all surfaces in the layer animate
+ *                                            with one timeline
+ *
+ * @param[in]   client      Weyland client
+ * @param[in]   resource    resource of request
+ * @param[in]   layer       layer id
+ * @param[in]   visible     visible(1=show/0=hide)
+ * @param[in]   animation   animation name(if empty, default animation)
+ * @param[in]   time        animation time(ms), if 0, default time
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+uifw_set_layer_visible_animation(struct wl_client *client, struct wl_resource *resource,
+                                 int32_t layer, int32_t visible,
+                                 const char *animation, int32_t time)
+{
+    struct uifw_win_surface *usurf;
+    struct uifw_layer_animation *layer_animation;
+    const struct uifw_animation_ops *ops = NULL;
+    int     type;
+    int     num;
+    uifw_watch("window_mgr.set_layer_visible_animation", layer, visible);
+
+    uifw_trace("uifw_set_layer_visible_animation: Enter(layer=%d, visilbe=%d, %s, %d)",
+               layer, visible, animation, time);
+
+    if ((*animation != 0) && (*animation != ' '))   {
+        type = ico_get_animation_type(animation);
+    }
+    else    {
+        type = ico_get_animation_type(ivi_shell_default_animation(NULL, NULL));
+    }
+    if (type != ICO_WINDOW_MGR_ANIMATION_NONE)  {
+        ops = _ico_win_mgr->animation[type - 1].ops;
+    }
+
+    wl_list_for_each (layer_animation, &_ico_win_mgr->layer_animation_list, link)  {
+        if (layer_animation->layer == layer)    break;
+    }
+    if ((&layer_animation->link != &_ico_win_mgr->layer_animation_list) &&
+        (layer_animation->ops == ops))  {
+        /* same animation running, reverse from current state   */
+        if (layer_animation->visible != (visible ? 1 : 0))  {
+            layer_animation->visible = visible ? 1 : 0;
+            layer_animation->state = visible ? ICO_WINDOW_MGR_ANIMATION_STATE_IN :
+                                               ICO_WINDOW_MGR_ANIMATION_STATE_OUT;
+            (*ops->start_layer)(layer_animation);
+        }
+        uifw_trace("uifw_set_layer_visible_animation: Leave(retarget)");
+        return;
+    }
+    win_mgr_layer_animation_finish(layer);
+    if ((! ops) || (! ops->start_layer))    {
+        ivi_shell_set_layer_visible(layer, visible);
+        uifw_trace("uifw_set_layer_visible_animation: Leave(no animation)");
+        return;
+    }
+
+    /* count visible surfaces in the layer  */
+    num = 0;
+    wl_list_for_each (usurf, &_ico_win_mgr->surface_list, link) {
+        if ((usurf->layer == layer) && (usurf->surface != NULL) &&
+            (ivi_shell_is_visible(usurf->shsurf)))  {
+            num ++;
+        }
+    }
+    if (num <= 0)   {
+        ivi_shell_set_layer_visible(layer, visible);
+        uifw_trace("uifw_set_layer_visible_animation: Leave(no visible surface)");
+        return;
+    }
+
+    layer_animation = malloc(sizeof(struct uifw_layer_animation) +
+                             sizeof(struct uifw_win_surface *) * num);
+    if (! layer_animation)  {
+        uifw_error("uifw_set_layer_visible_animation: No Memory");
+        ivi_shell_set_layer_visible(layer, visible);
+        return;
+    }
+    memset(layer_animation, 0, sizeof(struct uifw_layer_animation));
+    layer_animation->layer = layer;
+    layer_animation->visible = visible ? 1 : 0;
+    layer_animation->state = visible ? ICO_WINDOW_MGR_ANIMATION_STATE_IN :
+                                       ICO_WINDOW_MGR_ANIMATION_STATE_OUT;
+    layer_animation->time = (time > 0) ? time : 0;
+    layer_animation->ops = ops;
+    layer_animation->end = win_mgr_layer_animation_end;
+    wl_list_init(&layer_animation->link);
+
+    num = 0;
+    wl_list_for_each (usurf, &_ico_win_mgr->surface_list, link) {
+        if ((usurf->layer != layer) || (usurf->surface == NULL) ||
+            (! ivi_shell_is_visible(usurf->shsurf)))    {
+            continue;
+        }
+        /* surface animation is replaced by layer animation */
+        if (usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) {
+            win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_OPCANCEL, usurf);
+        }
+        usurf->animation.ops = ops;
+        usurf->layer_animation = layer_animation;
+        layer_animation->usurf[num++] = usurf;
+    }
+    layer_animation->num_surface = num;
+    wl_list_insert(&_ico_win_mgr->layer_animation_list, &layer_animation->link);
+
+    if (visible)    {
+        /* surfaces must be drawn while show animation  */
+        ivi_shell_set_layer_visible(layer, 1);
+    }
+    if ((*ops->start_layer)(layer_animation) == ICO_WINDOW_MGR_ANIMATION_RET_NOANIMA)  {
+        win_mgr_layer_animation_end(layer_animation);
+        uifw_trace("uifw_set_layer_visible_animation: Leave(animation error)");
+        return;
+    }
+    uifw_trace("uifw_set_layer_visible_animation: Leave(%d surfaces)", num);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   win_mgr_layer_animation_end: end of layer animation,
+ *                                       layer visibility changes at once
+ *
+ * @param[in]   layer_animation layer animation
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+win_mgr_layer_animation_end(struct uifw_layer_animation *layer_animation)
+{
+    int     i;
+
+    uifw_trace("win_mgr_layer_animation_end: Enter(layer=%d, visible=%d)",
+               layer_animation->layer, layer_animation->visible);
+
+    for (i = 0; i < layer_animation->num_surface; i++)  {
+        if (layer_animation->usurf[i])  {
+            layer_animation->usurf[i]->layer_animation = NULL;
+        }
+    }
+    wl_list_remove(&layer_animation->link);
+
+    ivi_shell_set_layer_visible(layer_animation->layer, layer_animation->visible);
+    free(layer_animation);
+
+    uifw_trace("win_mgr_layer_animation_end: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   win_mgr_layer_animation_remove: remove surface from layer animation
+ *
+ * @param[in]   usurf       UIFW surface
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+win_mgr_layer_animation_remove(struct uifw_win_surface *usurf)
+{
+    struct uifw_layer_animation *layer_animation = usurf->layer_animation;
+    int     i;
+
+    uifw_trace("win_mgr_layer_animation_remove: %08x from layer %d",
+               usurf->id, layer_animation->layer);
+
+    for (i = 0; i < layer_animation->num_surface; i++)  {
+        if (layer_animation->usurf[i] == usurf) {
+            layer_animation->usurf[i] = NULL;
+            break;
+        }
+    }
+    usurf->layer_animation = NULL;
+    win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_OPCANCEL, usurf);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   win_mgr_layer_animation_finish: finish running layer animation at once
+ *
+ * @param[in]   layer       layer id(-1=all layers)
+ * @return      none
+ */
+/*--------------------------------------------------------------------------*/
+static void
+win_mgr_layer_animation_finish(const int layer)
+{
+    struct uifw_layer_animation *layer_animation;
+    struct uifw_layer_animation *next;
+
+    wl_list_for_each_safe (layer_animation, next,
+                           &_ico_win_mgr->layer_animation_list, link)  {
+        if ((layer >= 0) && (layer_animation->layer != layer))  continue;
+        uifw_trace("win_mgr_layer_animation_finish: layer %d", layer_animation->layer);
+        /* the last frame calls end of layer animation  */
+        (*layer_animation->animation.frame)(&layer_animation->animation, NULL, 0);
+    }
+}
+
 /*--------------------------------------------------------------------------*/
 /**
  * @brief   uifw_set_client_attr: set client application attribute
@@ -1361,6 +1803,7 @@ uifw_set_client_attr(struct wl_client *client, struct wl_resource *resource,
     struct uifw_client_attr *lattr;
     struct uifw_client  *uclient;
     int     idx, freeidx;
+    uifw_watch("window_mgr.set_client_attr", attr, value);
 
     uifw_trace("uifw_set_client_attr: Enter(appid=%s, attr=%d, value=%d)",
                appid, attr, value);
@@ -1470,9 +1913,11 @@ win_mgr_surface_change_mgr(struct weston_surface *surface,
  */
 /*--------------------------------------------------------------------------*/
 static void
-win_mgr_surface_change(struct weston_surface *surface, const int to, const int manager)
+win_mgr_surface_change(struct weston_surface *surface, const int to, const int manager,
+                       void *data)
 {
     struct uifw_win_surface *usurf;
+    uifw_watch("window_mgr.hook_change", surface, to);
 
     uifw_trace("win_mgr_surface_change: Enter(%08x,%d,%d)", (int)surface, to, manager);
 
@@ -1508,13 +1953,16 @@ win_mgr_surface_change(struct weston_surface *surface, const int to, const int m
  * @brief   win_mgr_surface_select: select surface by Bottun/Touch
  *
  * @param[in]   surface     Weston surface
- * @return      none
+ * @return      handled or not
+ * @retval      1           handled(manager activates surface)
+ * @retval      0           not handled(not managed surface)
  */
 /*--------------------------------------------------------------------------*/
-static void
-win_mgr_surface_select(struct weston_surface *surface)
+static int
+win_mgr_surface_select(struct weston_surface *surface, void *data)
 {
     struct uifw_win_surface *usurf;
+    uifw_watch("window_mgr.hook_select", surface, 0);
 
     uifw_trace("win_mgr_surface_select: Enter(%08x)", (int)surface);
 
@@ -1522,7 +1970,7 @@ win_mgr_surface_select(struct weston_surface *surface)
     usurf = find_uifw_win_surface_by_ws(surface);
     if (! usurf) {
         uifw_trace("win_mgr_surface_select: Leave(Not Exist)");
-        return;
+        return 0;
     }
 
     /* send active event to manager     */
@@ -1530,6 +1978,7 @@ win_mgr_surface_select(struct weston_surface *surface)
                             usurf->id, NULL, ICO_IVI_SHELL_ACTIVE_SELECTED, 0,0,0,0,0);
 
     uifw_trace("win_mgr_surface_select: Leave(OK)");
+    return 1;
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1541,12 +1990,14 @@ win_mgr_surface_select(struct weston_surface *surface)
  */
 /*--------------------------------------------------------------------------*/
 static void
-win_mgr_surface_destroy(struct weston_surface *surface)
+win_mgr_surface_destroy(struct weston_surface *surface, void *data)
 {
     struct uifw_win_surface *usurf;
     struct uifw_win_surface *phash;
     struct uifw_win_surface *bhash;
+    struct ico_ivi_hook     *hook;
     uint32_t    hash;
+    uifw_watch("window_mgr.hook_destroy", surface, 0);
 
     uifw_trace("win_mgr_surface_destroy: Enter(%08x)", (int)surface);
 
@@ -1557,9 +2008,10 @@ win_mgr_surface_destroy(struct weston_surface *surface)
     }
 
     /* destory animation extenson   */
-    if (win_mgr_hook_animation) {
-        (*win_mgr_hook_animation)(ICO_WINDOW_MGR_ANIMATION_DESTROY, (void *)usurf);
+    if (usurf->layer_animation) {
+        win_mgr_layer_animation_remove(usurf);
     }
+    win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_DESTROY, usurf);
     hash = MAKE_IDHASH(usurf->id);
     phash = _ico_win_mgr->idhash[hash];
     bhash = NULL;
@@ -1598,9 +2050,10 @@ win_mgr_surface_destroy(struct weston_surface *surface)
     _ico_win_mgr->surfaceid_map[(hash - 1)/16] &= ~(1 << ((hash - 1) % 16));
 
     free(usurf);
+    ico_ivi_metric_add(_ico_win_mgr->m_surfaces, -1);
 
-    if (win_mgr_hook_destroy) {
-        (void) (*win_mgr_hook_destroy) (surface);
+    ico_ivi_hook_for_each (hook, &win_mgr_hook_destroy) {
+        (*(void (*)(struct weston_surface *, void *))hook->func)(surface, hook->data);
     }
     uifw_trace("win_mgr_surface_destroy: Leave(OK)");
 }
@@ -1622,6 +2075,7 @@ bind_ico_win_mgr(struct wl_client *client,
 {
     struct wl_resource *add_resource;
     struct uifw_manager *nm;
+    uifw_watch("window_mgr.bind", client, id);
 
     uifw_trace("bind_ico_win_mgr: Enter(client=%08x, id=%x)", (int)client, (int)id);
 
@@ -1650,6 +2104,7 @@ static void
 unbind_ico_win_mgr(struct wl_resource *resource)
 {
     struct uifw_manager *mgr, *itmp;
+    uifw_watch("window_mgr.unbind", resource, 0);
 
     uifw_trace("unbind_ico_win_mgr: Enter");
 
@@ -1711,6 +2166,8 @@ ico_win_mgr_send_to_mgr(const int event, const int surfaceid, const char *appid,
     int     num_mgr = 0;
     struct uifw_manager* mgr;
 
+    uifw_btrace(ICO_TP_WINMGR_SEND, event, surfaceid, param1, param2, param3, param4);
+
     wl_list_for_each (mgr, &_ico_win_mgr->manager_list, link)   {
         if (mgr->eventcb)   {
             num_mgr ++;
@@ -1758,69 +2215,311 @@ ico_win_mgr_send_to_mgr(const int event, const int surfaceid, const char *appid,
             }
         }
     }
+    ico_ivi_metric_add(_ico_win_mgr->m_events, num_mgr);
     return num_mgr;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_win_mgr_hook_set_user: set hook function for set user
+ * @brief   ico_win_mgr_add_hook_set_user: add hook function for set user
  *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
  * @param[in]   hook_set_user   hook function
- * @return      none
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ico_win_mgr_hook_set_user(void (*hook_set_user)(struct wl_client *client,
-                                                const char *appid))
+WL_EXPORT int
+ico_win_mgr_add_hook_set_user(const int priority,
+                              void (*hook_set_user)(struct wl_client *client,
+                                  const char *appid, void *data),
+                              void *data)
 {
-    uifw_trace("ico_win_mgr_hook_set_user: Hook %08x", (int)hook_set_user);
-    win_mgr_hook_set_user = hook_set_user;
+    return ico_ivi_hook_add(&win_mgr_hook_set_user, priority,
+                            (void (*)(void))hook_set_user, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_win_mgr_hook_create: set hook function for create surface
+ * @brief   ico_win_mgr_remove_hook_set_user: remove hook function for set user
  *
+ * @param[in]   hook_set_user   hook function
+ * @param[in]   data            user data(same as ico_win_mgr_add_hook_set_user)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ico_win_mgr_remove_hook_set_user(void (*hook_set_user)(struct wl_client *client,
+                                     const char *appid, void *data),
+                                 void *data)
+{
+    return ico_ivi_hook_remove(&win_mgr_hook_set_user, (void (*)(void))hook_set_user, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_win_mgr_add_hook_create: add hook function for create surface
+ *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
  * @param[in]   hook_create     hook function
- * @return      none
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
  */
 /*--------------------------------------------------------------------------*/
-WL_EXPORT void
-ico_win_mgr_hook_create(void (*hook_create)(struct wl_client *client,
-                                            struct weston_surface *surface,
-                                            int surfaceId, const char *appid))
+WL_EXPORT int
+ico_win_mgr_add_hook_create(const int priority,
+                            void (*hook_create)(struct wl_client *client,
+                                struct weston_surface *surface, int surfaceId,
+                                const char *appid, void *data),
+                            void *data)
+{
+    return ico_ivi_hook_add(&win_mgr_hook_create, priority,
+                            (void (*)(void))hook_create, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_win_mgr_remove_hook_create: remove hook function for create surface
+ *
+ * @param[in]   hook_create     hook function
+ * @param[in]   data            user data(same as ico_win_mgr_add_hook_create)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ico_win_mgr_remove_hook_create(void (*hook_create)(struct wl_client *client,
+                                   struct weston_surface *surface, int surfaceId,
+                                   const char *appid, void *data),
+                               void *data)
+{
+    return ico_ivi_hook_remove(&win_mgr_hook_create, (void (*)(void))hook_create, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_win_mgr_add_hook_destroy: add hook function for destroy surface
+ *
+ * @param[in]   priority        priority(ICO_IVI_HOOK_PRIORITY_xxx)
+ * @param[in]   hook_destroy    hook function
+ * @param[in]   data            user data(last argument of hook function)
+ * @return      result(ICO_IVI_EOK=success, other=error)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ico_win_mgr_add_hook_destroy(const int priority,
+                             void (*hook_destroy)(struct weston_surface *surface,
+                                                  void *data),
+                             void *data)
 {
-    uifw_trace("ico_win_mgr_hook_create: Hook %08x", (int)hook_create);
-    win_mgr_hook_create = hook_create;
+    return ico_ivi_hook_add(&win_mgr_hook_destroy, priority,
+                            (void (*)(void))hook_destroy, data);
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_win_mgr_hook_destroy: set hook function for destroy surface
+ * @brief   ico_win_mgr_remove_hook_destroy: remove hook function for destroy surface
  *
- * @param[in]   hook_destroy        hook function
+ * @param[in]   hook_destroy    hook function
+ * @param[in]   data            user data(same as ico_win_mgr_add_hook_destroy)
+ * @return      result(ICO_IVI_EOK=success, ICO_IVI_ENOENT=not exist)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ico_win_mgr_remove_hook_destroy(void (*hook_destroy)(struct weston_surface *surface,
+                                                     void *data),
+                                void *data)
+{
+    return ico_ivi_hook_remove(&win_mgr_hook_destroy, (void (*)(void))hook_destroy, data);
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_window_mgr_restrain_configure: restrain surface while animation,
+ *                                             at release, requests received while
+ *                                             restrained are applied at once
+ *
+ * @param[in]   usurf       UIFW surface
+ * @param[in]   restrain    restrain(1)/release(0)
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 WL_EXPORT void
-ico_win_mgr_hook_destroy(void (*hook_destroy)(struct weston_surface *surface))
+ico_window_mgr_restrain_configure(struct uifw_win_surface *usurf, const int restrain)
+{
+    struct weston_surface *es = usurf->surface;
+    int     flags;
+    int     visible;
+    int     raise;
+
+    if (restrain)   {
+        ivi_shell_restrain_configure(usurf->shsurf, 1);
+        return;
+    }
+
+    flags = usurf->pending.flags;
+    usurf->pending.flags = 0;
+    if (flags == 0) {
+        ivi_shell_restrain_configure(usurf->shsurf, 0);
+        return;
+    }
+    uifw_trace("ico_window_mgr_restrain_configure: Enter(%08x pending=%x)",
+               usurf->id, flags);
+
+    /* apply pending requests       */
+    if ((flags & ICO_WINDOW_MGR_PENDING_LAYER) && (usurf->layer != usurf->pending.layer))   {
+        usurf->layer = usurf->pending.layer;
+        ivi_shell_set_layer(usurf->shsurf, usurf->layer);
+    }
+    if (flags & ICO_WINDOW_MGR_PENDING_GEOMETRY)    {
+        usurf->x = usurf->pending.x;
+        usurf->y = usurf->pending.y;
+        usurf->width = usurf->pending.width;
+        usurf->height = usurf->pending.height;
+        ivi_shell_set_positionsize(usurf->shsurf,
+                                   usurf->x, usurf->y, usurf->width, usurf->height);
+    }
+    visible = ICO_WINDOW_MGR_VISIBLE_NOCHANGE;
+    raise = ICO_WINDOW_MGR_RAISE_NOCHANGE;
+    if (flags & ICO_WINDOW_MGR_PENDING_VISIBLE) {
+        if ((usurf->pending.visible == ICO_WINDOW_MGR_VISIBLE_SHOW) &&
+            (! ivi_shell_is_visible(usurf->shsurf)))    {
+            ivi_shell_set_visible(usurf->shsurf, 1);
+            ivi_shell_set_toplevel(usurf->shsurf);
+            visible = 1;
+        }
+        else if ((usurf->pending.visible == ICO_WINDOW_MGR_VISIBLE_HIDE) &&
+                 (ivi_shell_is_visible(usurf->shsurf)))  {
+            ivi_shell_set_visible(usurf->shsurf, 0);
+            visible = 0;
+        }
+        if ((usurf->pending.raise == ICO_WINDOW_MGR_RAISE_LOWER) ||
+            (usurf->pending.raise == ICO_WINDOW_MGR_RAISE_RAISE))   {
+            raise = usurf->pending.raise;
+            ivi_shell_set_raise(usurf->shsurf, raise);
+        }
+    }
+
+    /* one configure and restack    */
+    ivi_shell_restrain_configure(usurf->shsurf, 0);
+    if (flags & ICO_WINDOW_MGR_PENDING_GEOMETRY)    {
+        uifw_set_weston_surface(usurf);
+    }
+    if ((es) && (es->buffer) && (es->output))   {
+        weston_surface_damage_below(es);
+        weston_surface_damage(es);
+        weston_compositor_schedule_repaint(_ico_win_mgr->compositor);
+    }
+
+    /* one notification to manager for each changed attribute   */
+    if (flags & (ICO_WINDOW_MGR_PENDING_GEOMETRY|ICO_WINDOW_MGR_PENDING_LAYER))  {
+        win_mgr_surface_change(es, 0, 1, NULL);
+    }
+    if ((visible != ICO_WINDOW_MGR_VISIBLE_NOCHANGE) ||
+        (raise != ICO_WINDOW_MGR_RAISE_NOCHANGE))   {
+        /* visible or raise really changed  */
+        ico_win_mgr_send_to_mgr(ICO_WINDOW_MGR_WINDOW_VISIBLE, usurf->id, NULL,
+                                visible, raise, 0, 0,0,0);
+    }
+    uifw_trace("ico_window_mgr_restrain_configure: Leave");
+}
+
+/*--------------------------------------------------------------------------*/
+/**
+ * @brief   ico_window_mgr_regist_animation: regist window animation
+ *
+ * @param[in]   name        animation name(not case sensitive)
+ * @param[in]   ops         animation operation table
+ * @return      animation type value
+ * @retval      > 0         success(animation type value)
+ * @retval      ICO_IVI_EINVAL  error(invalid name)
+ * @retval      ICO_IVI_ENOMEM  error(animation table overflow)
+ */
+/*--------------------------------------------------------------------------*/
+WL_EXPORT int
+ico_window_mgr_regist_animation(const char *name, const struct uifw_animation_ops *ops)
 {
-    uifw_trace("ico_win_mgr_hook_destroy: Hook %08x", (int)hook_destroy);
-    win_mgr_hook_destroy = hook_destroy;
+    struct uifw_animation   *anima;
+    uint32_t    hash;
+
+    uifw_trace("ico_window_mgr_regist_animation: Enter(%s,%08x)", name, (int)ops);
+
+    if ((! name) || (*name == 0) || (strlen(name) >= ICO_WINDOW_ANIMATION_LEN) ||
+        (strcasecmp(name, "none") == 0) || (! ops))    {
+        uifw_warn("ico_window_mgr_regist_animation: Leave(Invalid animation)");
+        return ICO_IVI_EINVAL;
+    }
+
+    anima = find_animation_by_name(name);
+    if (! anima)    {
+        /* new animation name, type value is fixed while weston running */
+        if (_ico_win_mgr->num_animation >= ICO_WINDOW_MGR_ANIMATION_MAX)    {
+            uifw_error("ico_window_mgr_regist_animation: Leave(%s table overflow)", name);
+            return ICO_IVI_ENOMEM;
+        }
+        anima = &_ico_win_mgr->animation[_ico_win_mgr->num_animation++];
+        strncpy(anima->name, name, sizeof(anima->name)-1);
+        hash = animation_name_hash(name);
+        anima->hash = hash;
+        anima->next_hash = _ico_win_mgr->animation_hash[MAKE_ANIMAHASH(hash)];
+        _ico_win_mgr->animation_hash[MAKE_ANIMAHASH(hash)] = anima;
+    }
+    else if ((anima->ops) && (anima->ops != ops))   {
+        uifw_warn("ico_window_mgr_regist_animation: %s override", name);
+    }
+    anima->ops = ops;
+
+    uifw_trace("ico_window_mgr_regist_animation: Leave(%s=%d)",
+               name, (int)(anima - _ico_win_mgr->animation) + 1);
+    return (int)(anima - _ico_win_mgr->animation) + 1;
 }
 
 /*--------------------------------------------------------------------------*/
 /**
- * @brief   ico_window_mgr_set_animation: set animation hook routine
+ * @brief   ico_window_mgr_unregist_animation: unregist window animation
+ *                                             and cancel running animations
  *
- * @param[in]   hook_animation  hook routine
+ * @param[in]   ops         animation operation table
  * @return      none
  */
 /*--------------------------------------------------------------------------*/
 WL_EXPORT void
-ico_window_mgr_set_animation(int (*hook_animation)(const int op, void *data))
+ico_window_mgr_unregist_animation(const struct uifw_animation_ops *ops)
 {
-    win_mgr_hook_animation = hook_animation;
+    struct uifw_win_surface *usurf;
+    struct uifw_layer_animation *layer_animation;
+    struct uifw_layer_animation *next;
+    int     i;
+
+    uifw_trace("ico_window_mgr_unregist_animation: Enter(%08x)", (int)ops);
+
+    /* finish running layer animations  */
+    wl_list_for_each_safe (layer_animation, next,
+                           &_ico_win_mgr->layer_animation_list, link)  {
+        if (layer_animation->ops == ops)    {
+            (*layer_animation->animation.frame)(&layer_animation->animation, NULL, 0);
+        }
+    }
+
+    /* cancel running animations    */
+    wl_list_for_each (usurf, &_ico_win_mgr->surface_list, link) {
+        if (usurf->animation.ops != ops)    continue;
+        if ((usurf->animation.state != ICO_WINDOW_MGR_ANIMATION_STATE_NONE) ||
+            (usurf->animadata != NULL)) {
+            win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_OPCANCEL, usurf);
+            win_mgr_animation(ICO_WINDOW_MGR_ANIMATION_DESTROY, usurf);
+        }
+        usurf->animation.ops = NULL;
+    }
+
+    /* name and type value remain for re-regist     */
+    for (i = 0; i < _ico_win_mgr->num_animation; i++)   {
+        if (_ico_win_mgr->animation[i].ops == ops)  {
+            uifw_trace("ico_window_mgr_unregist_animation: %s(%d)",
+                       _ico_win_mgr->animation[i].name, i + 1);
+            _ico_win_mgr->animation[i].ops = NULL;
+        }
+    }
+    uifw_trace("ico_window_mgr_unregist_animation: Leave");
 }
 
 /*--------------------------------------------------------------------------*/
@@ -1856,6 +2555,11 @@ module_init(struct weston_compositor *ec)
     uifw_trace("ico_window_mgr: sh=%08x", (int)_ico_win_mgr);
     memset(_ico_win_mgr->surfaceid_map, 0, INIT_SURFACE_IDS/8);
 
+    _ico_win_mgr->m_surfaces = ico_ivi_metric_regist("window_mgr.surfaces",
+                                                     ICO_IVI_METRIC_GAUGE);
+    _ico_win_mgr->m_events = ico_ivi_metric_regist("window_mgr.events_sent",
+                                                   ICO_IVI_METRIC_COUNTER);
+
     _ico_win_mgr->compositor = ec;
 
     _ico_win_mgr->surfaceid_max = INIT_SURFACE_IDS;
@@ -1869,6 +2573,7 @@ module_init(struct weston_compositor *ec)
     }
 
     wl_list_init(&_ico_win_mgr->surface_list);
+    wl_list_init(&_ico_win_mgr->layer_animation_list);
     wl_list_init(&_ico_win_mgr->client_list);
     wl_list_init(&_ico_win_mgr->manager_list);
     wl_list_init(&_ico_win_mgr->client_attr_list);
@@ -1886,13 +2591,13 @@ module_init(struct weston_compositor *ec)
     ico_ivi_set_send_surface_change(win_mgr_surface_change_mgr);
 
     /* Hook to IVI-Shell                            */
-    ivi_shell_hook_bind(bind_shell_client);
-    ivi_shell_hook_unbind(unbind_shell_client);
-    ivi_shell_hook_create(client_register_surface);
-    ivi_shell_hook_destroy(win_mgr_surface_destroy);
-    ivi_shell_hook_map(win_mgr_map_surface);
-    ivi_shell_hook_change(win_mgr_surface_change);
-    ivi_shell_hook_select(win_mgr_surface_select);
+    ivi_shell_add_hook_bind(ICO_IVI_HOOK_PRIORITY_DEFAULT, bind_shell_client, NULL);
+    ivi_shell_add_hook_unbind(ICO_IVI_HOOK_PRIORITY_DEFAULT, unbind_shell_client, NULL);
+    ivi_shell_add_hook_create(ICO_IVI_HOOK_PRIORITY_DEFAULT, client_register_surface, NULL);
+    ivi_shell_add_hook_destroy(ICO_IVI_HOOK_PRIORITY_DEFAULT, win_mgr_surface_destroy, NULL);
+    ivi_shell_add_hook_map(ICO_IVI_HOOK_PRIORITY_DEFAULT, win_mgr_map_surface, NULL);
+    ivi_shell_add_hook_change(ICO_IVI_HOOK_PRIORITY_DEFAULT, win_mgr_surface_change, NULL);
+    ivi_shell_add_hook_select(ICO_IVI_HOOK_PRIORITY_DEFAULT, win_mgr_surface_select, NULL);
 
     uifw_info("ico_window_mgr: Leave(module_init)");
 
@@ -44,6 +44,8 @@ struct uifw_client  {
 
 /* UIFW surface                         */
 struct shell_surface;
+struct uifw_animation_ops;
+struct uifw_layer_animation;
 struct uifw_win_surface {
     uint32_t id;                            /* UIFW SurfaceId                       */
     int     layer;                          /* LayerId                              */
@@ -64,13 +66,32 @@ struct uifw_win_surface {
         char    visible;                    /* need visible(1)/hide(2) at end of animation*/
         char    res[2];                     /* (unused)                             */
         uint32_t starttime;                 /* start time(ms)                       */
+        const struct uifw_animation_ops *ops;   /* current animation operation      */
     }       animation;
     void    *animadata;                     /* animation data                       */
+    struct  _uifw_win_surface_pending {     /* request while restrained(animation)  */
+        char    flags;                      /* pending request(PENDING_xxx)         */
+        char    visible;                    /* visible(ICO_WINDOW_MGR_VISIBLE_xxx)  */
+        char    raise;                      /* raise(ICO_WINDOW_MGR_RAISE_xxx)      */
+        char    res;                        /* (unused)                             */
+        int     layer;                      /* LayerId                              */
+        int     x;                          /* X-axis                               */
+        int     y;                          /* Y-axis                               */
+        int     width;                      /* Width                                */
+        int     height;                     /* Height                               */
+    }       pending;
+    struct uifw_layer_animation *layer_animation;
+                                            /* layer animation(NULL=not grouped)    */
     struct wl_list link;                    /* surface link list                    */
     struct uifw_win_surface *next_idhash;   /* UIFW SurfaceId hash list             */
     struct uifw_win_surface *next_wshash;   /* Weston SurfaceId hash list           */
 };
 
+/* pending request while restrained     */
+#define ICO_WINDOW_MGR_PENDING_GEOMETRY     0x01    /* position/size                */
+#define ICO_WINDOW_MGR_PENDING_VISIBLE      0x02    /* visible/raise                */
+#define ICO_WINDOW_MGR_PENDING_LAYER        0x04    /* layer                        */
+
 /* animation operation                  */
 /* default animation                    */
 #define ICO_WINDOW_MGR_ANIMATION_NONE           0   /* no animation                 */
@@ -88,7 +109,6 @@ struct uifw_win_surface {
 #define ICO_WINDOW_MGR_ANIMATION_STATE_RESIZE   4   /* resize animation             */
 
 /* extended(plugin) animation operation */
-#define ICO_WINDOW_MGR_ANIMATION_TYPE       0       /* convert animation name to value*/
 #define ICO_WINDOW_MGR_ANIMATION_DESTROY    99      /* surface destroy              */
 #define ICO_WINDOW_MGR_ANIMATION_OPIN       1       /* change to show               */
 #define ICO_WINDOW_MGR_ANIMATION_OPOUT      2       /* change to hide               */
@@ -96,11 +116,66 @@ struct uifw_win_surface {
 #define ICO_WINDOW_MGR_ANIMATION_OPRESIZE   4       /* surface resize               */
 #define ICO_WINDOW_MGR_ANIMATION_OPCANCEL   9       /* animation cancel             */
 
+/* maximum number of registered animations */
+#define ICO_WINDOW_MGR_ANIMATION_MAX        32
+
+/* animation operation table(registered by animation plugin)    */
+/*   the table must exist while it is registered                */
+struct uifw_animation_ops {
+    int     (*start)(struct uifw_win_surface *usurf, const int op);
+                                            /* start animation(OPIN/OPOUT)          */
+                                            /* return ICO_WINDOW_MGR_ANIMATION_RET_xxx*/
+    void    (*frame)(struct weston_animation *animation,
+                     struct weston_output *output, uint32_t msecs);
+                                            /* animation frame(set to weston)       */
+    void    (*end)(struct uifw_win_surface *usurf);
+                                            /* terminate animation(surface destroy) */
+    void    (*cancel)(struct uifw_win_surface *usurf);
+                                            /* cancel animation                     */
+    int     (*start_layer)(struct uifw_layer_animation *layer_animation);
+                                            /* start layer animation(NULL=no support)*/
+                                            /* return ICO_WINDOW_MGR_ANIMATION_RET_xxx*/
+};
+
+/* layer animation(all surfaces in the layer share one timeline)    */
+struct uifw_layer_animation {
+    struct weston_animation animation;      /* animation control(frame is set by plugin)*/
+    int     layer;                          /* LayerId                              */
+    char    visible;                        /* layer visible at end(1=show/0=hide)  */
+    char    state;                          /* animation state(STATE_IN/STATE_OUT)  */
+    short   time;                           /* animation time(ms, 0=default)        */
+    short   current;                        /* animation current percentage         */
+    short   res;                            /* (unused)                             */
+    uint32_t starttime;                     /* start time(ms)                       */
+    const struct uifw_animation_ops *ops;   /* animation operation                  */
+    void    (*end)(struct uifw_layer_animation *layer_animation);
+                                            /* end of animation(set by window mgr)  */
+    struct wl_list link;                    /* running layer animation list         */
+    int     num_surface;                    /* number of surfaces                   */
+    struct uifw_win_surface *usurf[];       /* surfaces(NULL=removed from animation)*/
+};
+
+/* animation data pool statistics(ico_window_animation) */
+struct uifw_animation_pool_stat {
+    int     size;                           /* current pool size                    */
+    int     live;                           /* number of animation data in use      */
+    int     peak;                           /* peak number of animation data in use */
+    int     fallback;                       /* number of allocations out of pool    */
+    int     failed;                         /* number of allocation failures        */
+};
+
 /* Prototype for function               */
                                             /* get client applicationId             */
 char *ico_window_mgr_appid(struct wl_client* client);
-                                            /* set window animation hook            */
-void ico_window_mgr_set_animation(int (*hook_animation)(const int op, void *data));
+                                            /* regist window animation              */
+int ico_window_mgr_regist_animation(const char *name,
+                                    const struct uifw_animation_ops *ops);
+                                            /* unregist window animation            */
+void ico_window_mgr_unregist_animation(const struct uifw_animation_ops *ops);
+                                            /* restrain surface while animation     */
+void ico_window_mgr_restrain_configure(struct uifw_win_surface *usurf, const int restrain);
+                                            /* get animation data pool statistics   */
+void ico_window_animation_pool_stat(struct uifw_animation_pool_stat *stat);
 
 #endif  /*_ICO_WINDOW_MGR_H_*/
 
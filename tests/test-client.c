@@ -305,10 +305,49 @@ cb_input_input(void *data, struct ico_exinput *ico_exinput, uint32_t time,
               device, input, code, state);
 }
 
+static void
+cb_input_inputs(void *data, struct ico_exinput *ico_exinput,
+                const char *device, struct wl_array *events)
+{
+    int32_t *rec;
+
+    /* record is (time, input, code, state) */
+    for (rec = events->data;
+         (const char *)rec < ((const char *)events->data + events->size); rec += 4)  {
+        print_log("CLIENT: Event[input_inputs] device=%s input=%d code=%d state=%d",
+                  device, rec[1], rec[2], rec[3]);
+    }
+}
+
+static void
+cb_input_capability_table(void *data, struct ico_exinput *ico_exinput,
+                          uint32_t version, uint32_t base, struct wl_array *table)
+{
+    uint32_t    *rec;
+    char        *device;
+    char        *swname;
+
+    print_log("CLIENT: Event[input_capability_table] version=%d base=%d size=%d",
+              version, base, (int)table->size);
+
+    /* record is (size, input, type, ncode, device, swname, codes)  */
+    for (rec = table->data;
+         (char *)rec < ((char *)table->data + table->size);
+         rec = (uint32_t *)((char *)rec + rec[0]))  {
+        device = (char *)&rec[5];
+        swname = (char *)&rec[6 + ((rec[4] + 3) / 4)];
+        print_log("CLIENT:   device=%s type=%d sw=%s input=%d codes=%d",
+                  device, rec[2], swname, rec[1], rec[3]);
+        if (rec[0] == 0)    break;
+    }
+}
+
 static const struct ico_exinput_listener exinput_listener = {
     cb_input_capabilities,
     cb_input_code,
-    cb_input_input
+    cb_input_input,
+    cb_input_inputs,
+    cb_input_capability_table
 };
 
 static void
@@ -386,7 +425,7 @@ handle_global(void *data, struct wl_registry *registry, uint32_t id,
     }
     else if (strcmp(interface, "ico_exinput") == 0)   {
         display->ico_exinput = wl_registry_bind(display->registry, id,
-                                                &ico_exinput_interface, 1);
+                                                &ico_exinput_interface, 3);
         ico_exinput_add_listener(display->ico_exinput, &exinput_listener, display);
         print_log("CLIENT: created exinput global %p", display->ico_exinput);
     }
@@ -634,10 +634,62 @@ cb_input_input(void *data, struct ico_exinput *ico_exinput, uint32_t time,
               device, input, code, state);
 }
 
+static void
+cb_input_inputs(void *data, struct ico_exinput *ico_exinput,
+                const char *device, struct wl_array *events)
+{
+    int32_t *rec;
+
+    /* record is (time, input, code, state) */
+    for (rec = events->data;
+         (const char *)rec < ((const char *)events->data + events->size); rec += 4)  {
+        print_log("HOMESCREEN: Event[input_inputs] device=%s input=%d code=%d state=%d",
+                  device, rec[1], rec[2], rec[3]);
+    }
+}
+
+static void
+cb_input_capability_table(void *data, struct ico_exinput *ico_exinput,
+                          uint32_t version, uint32_t base, struct wl_array *table)
+{
+    uint32_t    *rec;
+    char        *device;
+    char        *swname;
+
+    print_log("HOMESCREEN: Event[input_capability_table] version=%d base=%d size=%d",
+              version, base, (int)table->size);
+
+    /* record is (size, input, type, ncode, device, swname, codes)  */
+    for (rec = table->data;
+         (char *)rec < ((char *)table->data + table->size);
+         rec = (uint32_t *)((char *)rec + rec[0]))  {
+        device = (char *)&rec[5];
+        swname = (char *)&rec[6 + ((rec[4] + 3) / 4)];
+        print_log("HOMESCREEN:   device=%s type=%d sw=%s input=%d codes=%d",
+                  device, rec[2], swname, rec[1], rec[3]);
+        if (rec[0] == 0)    break;
+    }
+}
+
 static const struct ico_exinput_listener exinput_listener = {
     cb_input_capabilities,
     cb_input_code,
-    cb_input_input
+    cb_input_input,
+    cb_input_inputs,
+    cb_input_capability_table
+};
+
+static void
+cb_input_latency(void *data, struct ico_input_mgr_control *ico_input_mgr,
+                 const char *target, int32_t kind, uint32_t count,
+                 uint32_t p50, uint32_t p99, uint32_t max, struct wl_array *buckets)
+{
+    print_log("HOMESCREEN: Event[input_latency] target=%s kind=%d count=%d "
+              "p50=%dus p99=%dus max=%dus", target, kind, count, p50, p99, max);
+}
+
+static const struct ico_input_mgr_control_listener input_mgr_listener = {
+    cb_input_latency
 };
 
 static void
@@ -691,17 +743,19 @@ handle_global(void *data, struct wl_registry *registry, uint32_t id,
     }
     else if (strcmp(interface, "ico_input_mgr_control") == 0)   {
         display->ico_input_mgr = wl_registry_bind(display->registry, id,
-                                                  &ico_input_mgr_control_interface, 1);
+                                                  &ico_input_mgr_control_interface, 2);
+        ico_input_mgr_control_add_listener(display->ico_input_mgr,
+                                           &input_mgr_listener, display);
         print_log("HOMESCREEN: created input_mgr global %p", display->ico_input_mgr);
     }
     else if (strcmp(interface, "ico_input_mgr_device") == 0)   {
         display->ico_input_device = wl_registry_bind(display->registry, id,
-                                                     &ico_input_mgr_device_interface, 1);
+                                                     &ico_input_mgr_device_interface, 2);
         print_log("HOMESCREEN: created input_device global %p", display->ico_input_device);
     }
     else if (strcmp(interface, "ico_exinput") == 0)   {
         display->ico_exinput =
-            wl_registry_bind(display->registry, id, &ico_exinput_interface, 1);
+            wl_registry_bind(display->registry, id, &ico_exinput_interface, 2);
         ico_exinput_add_listener(display->ico_exinput, &exinput_listener, display);
         print_log("HOMESCREEN: created exinput global %p", display->ico_exinput);
 
@@ -967,18 +1021,23 @@ show_surface(struct display *display, char *buf, const int show)
     char    *args[10];
     int     narg;
     int     surfaceid;
+    int     anima;
 
     narg = pars_command(buf, args, 10);
     if (narg >= 1)  {
         surfaceid = search_surface(display, args[0]);
+        /* 2nd argument "a" is with animation   */
+        anima = ((narg >= 2) && (strcasecmp(args[1], "a") == 0)) ? 2 : 0;
         if (surfaceid >= 0) {
             if (show)   {
-                print_log("HOMESCREEN: show(%s,%08x)", args[0], surfaceid);
-                ico_window_mgr_set_visible(display->ico_window_mgr, surfaceid, 1, 9);
+                print_log("HOMESCREEN: show(%s,%08x,%d)", args[0], surfaceid, anima);
+                ico_window_mgr_set_visible(display->ico_window_mgr, surfaceid,
+                                           1 + anima, 9);
             }
             else    {
-                print_log("HOMESCREEN: hide(%s,%08x)", args[0], surfaceid);
-                ico_window_mgr_set_visible(display->ico_window_mgr, surfaceid, 0, 9);
+                print_log("HOMESCREEN: hide(%s,%08x,%d)", args[0], surfaceid, anima);
+                ico_window_mgr_set_visible(display->ico_window_mgr, surfaceid,
+                                           0 + anima, 9);
             }
         }
         else    {
@@ -986,7 +1045,7 @@ show_surface(struct display *display, char *buf, const int show)
         }
     }
     else    {
-        print_log("HOMESCREEN: show command[show/hide appid] has no argument");
+        print_log("HOMESCREEN: show command[show/hide appid [a]] has no argument");
     }
 }
 
@@ -1072,6 +1131,36 @@ visible_layer(struct display *display, char *buf)
     }
 }
 
+static void
+visible_layer_animation(struct display *display, char *buf)
+{
+    char    *args[10];
+    int     narg;
+    int     layer;
+    int     visible;
+    int     time;
+
+    narg = pars_command(buf, args, 10);
+    if (narg >= 2)  {
+        layer = strtol(args[0], (char **)0, 0);
+        visible = strtol(args[1], (char **)0, 0);
+        if (narg >= 4)  {
+            time = strtol(args[3], (char **)0, 0);
+        }
+        else    {
+            time = 0;
+        }
+        print_log("HOMESCREEN: layer_animation(%d,%d,%s,%d)",
+                  layer, visible, narg >= 3 ? args[2] : "", time);
+        ico_window_mgr_set_layer_visible_animation(display->ico_window_mgr, layer, visible,
+                                                   narg >= 3 ? args[2] : "", time);
+    }
+    else    {
+        print_log("HOMESCREEN: layer_animation command"
+                  "[layer_animation layer visible [animation [time]]] has no argument");
+    }
+}
+
 static void
 input_add(struct display *display, char *buf)
 {
@@ -1218,7 +1307,7 @@ input_sw(struct display *display, char *buf)
         state = strtol(args[3], (char **)0, 0);
         if ((input >= 0) && (state >= 0))   {
             gettimeofday(&stv, (struct timezone *)NULL);
-            timems = (stv.tv_sec % 1000) * 1000 + (stv.tv_usec / 1000);
+            timems = (int)((uint32_t)stv.tv_sec * 1000 + (stv.tv_usec / 1000));
             ico_input_mgr_device_input_event(display->ico_input_device,
                                              timems, args[0], input, code, state);
         }
@@ -1233,6 +1322,52 @@ input_sw(struct display *display, char *buf)
     }
 }
 
+static void
+input_sws(struct display *display, char *buf)
+{
+    char    *args[31];
+    int     narg;
+    int     timems;
+    int     i;
+    int32_t *rec;
+    struct wl_array events;
+    struct timeval  stv;
+
+    narg = pars_command(buf, args, 31);
+    if ((narg >= 4) && (((narg - 1) % 3) == 0))  {
+        gettimeofday(&stv, (struct timezone *)NULL);
+        timems = (int)((uint32_t)stv.tv_sec * 1000 + (stv.tv_usec / 1000));
+        wl_array_init(&events);
+        for (i = 1; i < narg; i += 3)   {
+            rec = wl_array_add(&events, sizeof(int32_t) * 4);
+            if (! rec)  break;
+            rec[0] = timems;
+            rec[1] = strtol(args[i], (char **)0, 0);
+            rec[2] = strtol(args[i+1], (char **)0, 0);
+            rec[3] = strtol(args[i+2], (char **)0, 0);
+        }
+        ico_input_mgr_device_input_events(display->ico_input_device, args[0], &events);
+        wl_array_release(&events);
+    }
+    else    {
+        print_log("HOMESCREEN: input_sws command[input_sws device input code state "
+                  "[input code state...]] has no argument");
+    }
+}
+
+static void
+input_latency(struct display *display, char *buf)
+{
+    char    *args[10];
+    int     narg;
+
+    narg = pars_command(buf, args, 10);
+    ico_input_mgr_control_query_latency(display->ico_input_mgr,
+                                        (narg >= 1) ? args[0] : "",
+                                        (narg >= 2) ? args[1] : "",
+                                        (narg >= 3) ? strtol(args[2], (char **)0, 0) : 0);
+}
+
 static void
 send_event(const char *cmd)
 {
@@ -1377,6 +1512,10 @@ int main(int argc, char *argv[])
             /* Launch test application      */
             kill_app(display, &buf[4]);
         }
+        else if (strncasecmp(buf, "layer_animation", 15) == 0) {
+            /* Change layer visiblety with animation*/
+            visible_layer_animation(display, &buf[15]);
+        }
         else if (strncasecmp(buf, "layer_visible", 13) == 0) {
             /* Change layer visiblety       */
             visible_layer(display, &buf[13]);
@@ -1437,6 +1576,14 @@ int main(int argc, char *argv[])
             /* input code configuration         */
             input_code(display, &buf[10]);
         }
+        else if (strncasecmp(buf, "input_latency", 13) == 0) {
+            /* query input latency histograms   */
+            input_latency(display, &buf[13]);
+        }
+        else if (strncasecmp(buf, "input_sws", 9) == 0) {
+            /* batched input switch events      */
+            input_sws(display, &buf[9]);
+        }
         else if (strncasecmp(buf, "input_sw", 8) == 0) {
             /* input switch event               */
             input_sw(display, &buf[8]);
@@ -81,6 +81,7 @@ static int  mqid = -1;
 static int  mDebug = 0;
 static int  mRun = 1;
 static int  mTouch = 1;
+static char mPipe[128];
 
 static void
 term_signal(const int signo)
@@ -119,6 +120,18 @@ init_device(const char *device)
     char    devFile[64];
     char    devName[64];
     struct uinput_user_dev  uinputDevice;
+
+    if (mPipe[0])   {
+        /* write events to pipe(FIFO) instead of uinput device  */
+        uifd = open(mPipe, O_WRONLY);
+        if (uifd < 0)   {
+            print_log("%s open error[%d]", mPipe, errno);
+            fflush(stderr);
+            exit(1);
+        }
+        print_log("## opened event pipe %s", mPipe);
+        return;
+    }
     uifd = open("/dev/uinput", O_RDWR);
 
     if (uifd < 0)   {
@@ -416,7 +429,7 @@ send_event(const char *cmd)
 static void
 usage(const char *prog)
 {
-    fprintf(stderr, "Usage: %s [-device=device] [{-m/-t/-j}] [-mq[=key]] "
+    fprintf(stderr, "Usage: %s [-device=device] [-pipe=fifo] [{-m/-t/-j}] [-mq[=key]] "
             "[-d] [event=value] [event=value] ...\n", prog);
     exit(0);
 }
@@ -439,6 +452,9 @@ main(int argc, char *argv[])
             if (strncasecmp(argv[i], "-device=", 8) == 0)   {
                 strcpy(buf, &argv[i][8]);
             }
+            else if (strncasecmp(argv[i], "-pipe=", 6) == 0)   {
+                strncpy(mPipe, &argv[i][6], sizeof(mPipe)-1);
+            }
             else if (strcasecmp(argv[i], "-m") == 0)   {
                 mTouch = 1;                 /* Simulate mouse               */
             }